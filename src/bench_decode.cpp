@@ -0,0 +1,190 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include "pdp_types.h"
+#include "pdp_reader.h"
+#include "pdp_fitness.h"
+
+using namespace std;
+
+// Decode throughput benchmark.
+// Usage: bench_decode [--iters N] [--depot MODE] <instance_file>...
+//        bench_decode --check <instance_file>...
+// Builds a fixed pool of random chromosomes per instance (fixed seed) and
+// reports decodes/sec for decodeFromEncoding (full) and decodeCostOnly (cost),
+// plus costLowerBound: bounds/sec, mean bound / decoded cost, and the number of
+// chromosomes whose bound exceeds the decoded cost (must be 0).
+// --check skips the timing, tries every depot mode and exits 1 if any bound
+// exceeds its decoded cost (make check-bound runs it over Instances 2).
+
+static Chromosome randomChromosome(const PDPData& data, mt19937& gen) {
+    Chromosome c;
+    for (int i = 0; i < data.numNodes; ++i) {
+        if (data.isCustomer(i)) c.sequence.push_back(i);
+    }
+    shuffle(c.sequence.begin(), c.sequence.end(), gen);
+
+    int n = (int)c.sequence.size();
+    uniform_int_distribution<> truckDist(0, data.numTrucks - 1);
+    uniform_int_distribution<> droneDist(0, data.numDrones);
+    uniform_int_distribution<> bitDist(0, 1);
+    c.truck_assign.resize(n);
+    c.drone_assign.resize(n);
+    c.break_bit.resize(n);
+    for (int i = 0; i < n; ++i) {
+        int node = c.sequence[i];
+        c.truck_assign[i] = truckDist(gen);
+        bool droneNode = data.isDroneEligible(node);
+        c.drone_assign[i] = droneNode ? droneDist(gen) : 0;
+        c.break_bit[i] = bitDist(gen);
+    }
+    return c;
+}
+
+static const int POOL_SIZE = 256;
+
+static vector<Chromosome> makePool(const PDPData& data) {
+    mt19937 gen(12345);
+    vector<Chromosome> pool;
+    pool.reserve(POOL_SIZE);
+    for (int k = 0; k < POOL_SIZE; ++k) pool.push_back(randomChromosome(data, gen));
+    return pool;
+}
+
+// Chromosomes whose lower bound (C_max alone or with penalties) exceeds the decoded
+// cost; tightness gets the mean bound / decoded C_max
+static int countBoundViolations(const vector<Chromosome>& pool, const PDPData& data, double& tightness) {
+    tightness = 0.0;
+    int violations = 0;
+    for (const Chromosome& c : pool) {
+        PDPCost cost = decodeCostOnly(c, data);
+        double total = cost.totalCost + cost.totalPenalty;
+        double cmaxBound = costLowerBound(c, data, 0.0);
+        double slack = 1e-9 * max(1.0, total);
+        if (cmaxBound > cost.totalCost + slack || costLowerBound(c, data) > total + slack) violations++;
+        if (cost.totalCost > 0) tightness += cmaxBound / cost.totalCost;
+    }
+    tightness /= max<size_t>(1, pool.size());
+    return violations;
+}
+
+// --check: bound violations for every file and depot mode; 0 if there are none
+static int checkBounds(const vector<string>& files) {
+    int failed = 0;
+    int checked = 0;
+    for (const string& file : files) {
+        for (int depotMode = 0; depotMode <= 2; ++depotMode) {
+            PDPData data;
+            data.depotMode = depotMode;
+            ostringstream readerLog;  // Keep the per-instance summary out of the report
+            streambuf* coutBuf = cout.rdbuf(readerLog.rdbuf());
+            bool ok = readPDPFile(file, data);
+            cout.rdbuf(coutBuf);
+            if (!ok) {
+                cout << "[CHECK] " << file << ": cannot read" << endl;
+                return 1;
+            }
+            double tightness;
+            int violations = countBoundViolations(makePool(data), data, tightness);
+            checked++;
+            if (violations > 0) {
+                failed++;
+                cout << "[CHECK] " << file << " (depot " << depotMode << "): " << violations << " of "
+                     << POOL_SIZE << " lower bounds exceed the decoded cost" << endl;
+            }
+        }
+    }
+    cout << "[CHECK] " << files.size() << " instances x 3 depot modes x " << POOL_SIZE
+         << " chromosomes: " << failed << " of " << checked << " runs with bound violations" << endl;
+    return failed > 0 ? 1 : 0;
+}
+
+int main(int argc, char* argv[]) {
+    int iters = 20000;
+    int depotMode = 0;
+    bool check = false;
+    vector<string> files;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--iters" && i + 1 < argc) {
+            iters = stoi(argv[++i]);
+        } else if (arg == "--depot" && i + 1 < argc) {
+            depotMode = stoi(argv[++i]);
+        } else if (arg == "--check") {
+            check = true;
+        } else {
+            files.push_back(arg);
+        }
+    }
+    if (files.empty()) {
+        cerr << "Usage: " << argv[0] << " [--iters N] [--depot MODE] <instance_file>..." << endl;
+        cerr << "       " << argv[0] << " --check <instance_file>..." << endl;
+        return 1;
+    }
+    if (check) return checkBounds(files);
+
+    struct Row { string file; double full; double cost; double bound; double tightness; int violations; };
+    vector<Row> rows;
+
+    for (const string& file : files) {
+        PDPData data;
+        data.depotMode = depotMode;
+        if (!readPDPFile(file, data)) return 1;
+
+        vector<Chromosome> pool = makePool(data);
+
+        // Warm-up (also fills any per-thread scratch state).
+        double checksum = 0.0;
+        for (int k = 0; k < POOL_SIZE; ++k) {
+            PDPSolution sol = decodeFromEncoding(pool[k], data);
+            checksum += sol.totalCost + sol.totalPenalty;
+        }
+
+        auto t0 = chrono::steady_clock::now();
+        for (int k = 0; k < iters; ++k) {
+            PDPSolution sol = decodeFromEncoding(pool[k % POOL_SIZE], data);
+            checksum += sol.totalCost + sol.totalPenalty;
+        }
+        auto t1 = chrono::steady_clock::now();
+        double costChecksum = 0.0;
+        for (int k = 0; k < iters; ++k) {
+            PDPCost cost = decodeCostOnly(pool[k % POOL_SIZE], data);
+            costChecksum += cost.totalCost + cost.totalPenalty;
+        }
+        auto t2 = chrono::steady_clock::now();
+        double boundChecksum = 0.0;
+        for (int k = 0; k < iters; ++k) {
+            boundChecksum += costLowerBound(pool[k % POOL_SIZE], data);
+        }
+        auto t3 = chrono::steady_clock::now();
+        double rate = iters / max(chrono::duration<double>(t1 - t0).count(), 1e-9);
+        double costRate = iters / max(chrono::duration<double>(t2 - t1).count(), 1e-9);
+        double boundRate = iters / max(chrono::duration<double>(t3 - t2).count(), 1e-9);
+
+        // Bound quality on the pool: C_max alone and with penalties
+        double tightness;
+        int violations = countBoundViolations(pool, data, tightness);
+        rows.push_back({file, rate, costRate, boundRate, tightness, violations});
+
+        cout << "[BENCH] " << file << ": " << fixed << setprecision(0) << rate
+             << " decodes/sec, " << costRate << " cost-only/sec (" << iters
+             << " decodes, checksum " << setprecision(2) << checksum
+             << ", cost checksum " << costChecksum << "); lower bound: " << setprecision(0)
+             << boundRate << "/sec, " << setprecision(3) << tightness << " of C_max, "
+             << violations << " violations (checksum " << setprecision(2) << boundChecksum << ")" << endl;
+    }
+
+    cout << "\n" << left << setw(48) << "Instance" << right << setw(16) << "decodes/sec"
+         << setw(16) << "cost-only/sec" << setw(16) << "bound/sec" << setw(10) << "LB/C_max"
+         << setw(12) << "violations" << endl;
+    for (const auto& r : rows) {
+        cout << left << setw(48) << r.file << right << setw(16) << fixed << setprecision(0) << r.full
+             << setw(16) << r.cost << setw(16) << r.bound << setw(10) << setprecision(3) << r.tightness
+             << setw(12) << r.violations << endl;
+    }
+    return 0;
+}
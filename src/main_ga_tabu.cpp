@@ -3,14 +3,17 @@
 #include <sstream>
 #include <iomanip>
 #include <chrono>
+#include <cmath>
 #include "pdp_types.h"
 #include "pdp_reader.h"
 #include "pdp_utils.h"
 #include "pdp_ga.h"
+#include "pdp_config.h"
 #include "pdp_tabu.h"
 #include "pdp_fitness.h"
 #include "pdp_localsearch.h"
 #include "pdp_validation.h"
+#include "pdp_migration.h"
 
 using namespace std;
 
@@ -18,50 +21,105 @@ int main(int argc, char* argv[]) {
     // Start total timer
     auto startTotal = chrono::high_resolution_clock::now();
     
-    // Configuration parameters - modify these values directly
-    const int POPULATION_SIZE = 200;       // Balanced: quality vs speed
-    const int MAX_GENERATIONS = 500;       // Standard iterations
-    const double MUTATION_RATE = 0.15;     // Slightly higher diversity
-    const int RUN_NUMBER = 1;
-    
+    // Solver parameters: defaults, then --config FILE, then the other flags
+    SolverConfig config;
+
     if (argc < 2) {
-        cerr << "Usage: " << argv[0] << " <instance_file> [--depot MODE]" << endl;
-        cerr << "Depot modes:" << endl;
-        cerr << "  0 = center (default)" << endl;
-        cerr << "  1 = border" << endl;
-        cerr << "  2 = outside" << endl;
+        cerr << "Usage: " << argv[0] << " <instance_file> [--config FILE] [--OPTION VALUE ...]" << endl;
+        cerr << "       [--coordinator SOCKET --workers N] [--dump-config]" << endl;
+        cerr << "Options (also accepted as key=value lines or a flat JSON object in --config FILE;" << endl;
+        cerr << "flags given on the command line override the file):" << endl;
+        cerr << "--population N / --generations N / --mutation-rate R / --run N: GA size, length," << endl;
+        cerr << "  base mutation rate and run number (default 200 / 500 / 0.15 / 1)" << endl;
+        cerr << "--seed N: fixed RNG seed (default -1 = random); without --time-limit a seeded run" << endl;
+        cerr << "  gives the same result for any --threads (only the cache statistics differ)" << endl;
+        cerr << "--elite-decode-share S / --explore-decode-share S: offspring decoded in surrogate" << endl;
+        cerr << "  rank order / at random from the rest (default 0.5 / 0.1)" << endl;
+        cerr << "--tabu-threshold N: decoded evaluations without improvement before the tabu phase" << endl;
+        cerr << "  (default 0 = auto); --tabu-iterations N: iterations per tabu search (default 50)" << endl;
+        cerr << "--depot MODE: 0 = center (default), 1 = border, 2 = outside" << endl;
+        cerr << "--cache-mb MB: solution cache memory budget (default "
+             << SolutionCache::DEFAULT_MEMORY_BUDGET / (1024 * 1024) << ")" << endl;
+        cerr << "--cache-compact: cache only cost/penalty/feasibility keyed by a 128-bit fingerprint" << endl;
+        cerr << "--threads N: threads for offspring evaluation (default 0 = all cores, 1 = serial)" << endl;
+        cerr << "--islands K: island model with K populations, one thread each (default 1)" << endl;
+        cerr << "--migration-interval G / --migrants M: send M elites every G generations (default 10 / 2)" << endl;
+        cerr << "--topology ring|random: migration destination (default ring)" << endl;
+        cerr << "--coordinator SOCKET --workers N: collect migrants and the global best from N" << endl;
+        cerr << "  processes started with --join SOCKET (Unix domain socket, local only)" << endl;
+        cerr << "--granular K: restrict tabu swap/2-opt/Or-opt and truck 2-opt/swap/relocate to" << endl;
+        cerr << "  pairs within each other's K nearest neighbors (default 0 = off)" << endl;
+        cerr << "--ls-starts N: random starts of the multi-start assignment LS, run concurrently" << endl;
+        cerr << "  (default 0 = 3 per tabu result and 5 at the end);" << endl;
+        cerr << "  --tabu-ls-starts N / --final-ls-starts N set the two separately" << endl;
+        cerr << "--ls-iterations N: iterations per assignment LS start (default 50)" << endl;
+        cerr << "--time-limit SECONDS (or --time): wall-clock budget for the whole run; the final LS" << endl;
+        cerr << "  gets --final-ls-time-share of it (default 0.15), the GA + tabu phase the rest (0 = none)" << endl;
+        cerr << "--dump-config: print the resulting options as key=value lines and exit" << endl;
         cerr << "Examples:" << endl;
         cerr << "  " << argv[0] << " Instance/U_10_0.5_Num_1.txt" << endl;
         cerr << "  " << argv[0] << " Instance/U_30_0.5_Num_1.txt --depot 1" << endl;
-        cerr << "  " << argv[0] << " Instance/U_50_1.0_Num_1.txt --depot 2" << endl;
-        cerr << "\nCurrent parameters (edit in main_ga_tabu.cpp):" << endl;
-        cerr << "  Population Size: " << POPULATION_SIZE << endl;
-        cerr << "  Max Generations: " << MAX_GENERATIONS << endl;
-        cerr << "  Mutation Rate: " << MUTATION_RATE << endl;
-        cerr << "  Run Number: " << RUN_NUMBER << endl;
+        cerr << "  " << argv[0] << " Instance/U_50_1.0_Num_1.txt --config sweep.cfg --population 300" << endl;
         return 1;
     }
     string instanceFile = argv[1];
-    int populationSize = POPULATION_SIZE;
-    int maxGenerations = MAX_GENERATIONS;
-    double mutationRate = MUTATION_RATE;
-    int runNumber = RUN_NUMBER;
-    
-    // Parse optional --depot MODE argument (0=center, 1=border, 2=outside)
-    int depotMode = 0;  // default: center
+
+    string error;
+    for (int i = 2; i + 1 < argc; i++) {
+        if (string(argv[i]) == "--config" && !loadSolverConfig(argv[i + 1], config, error)) {
+            cerr << "Error: " << error << endl;
+            return 1;
+        }
+    }
+
+    string coordinatorSocket;   // non-empty: run as island coordinator instead of the GA
+    int coordinatorWorkers = 0;
+    bool dumpConfig = false;
     for (int i = 2; i < argc; i++) {
         string arg = argv[i];
-        if (arg == "--depot" && i + 1 < argc) {
-            istringstream modeStream(argv[i + 1]);
-            if (modeStream >> depotMode && depotMode >= 0 && depotMode <= 2) {
-                // valid mode
+        if (arg == "--config" && i + 1 < argc) {
+            i++;   // loaded above
+        } else if (arg == "--coordinator" && i + 1 < argc) {
+            coordinatorSocket = argv[i + 1];
+            i++;
+        } else if (arg == "--workers" && i + 1 < argc) {
+            istringstream workerStream(argv[i + 1]);
+            if (workerStream >> coordinatorWorkers && coordinatorWorkers >= 1) {
+                // valid worker count
             } else {
-                cerr << "Error: --depot MODE must be 0 (center), 1 (border), or 2 (outside)" << endl;
+                cerr << "Error: --workers N must be a positive integer" << endl;
                 return 1;
             }
             i++;
+        } else if (arg == "--dump-config") {
+            dumpConfig = true;
+        } else if (arg.compare(0, 2, "--") == 0 && hasSolverOption(arg.substr(2))) {
+            string key = arg.substr(2);
+            string value;
+            if (isSolverSwitch(key)) {
+                value = "true";
+            } else if (i + 1 < argc) {
+                value = argv[++i];
+            } else {
+                cerr << "Error: " << arg << " needs a value" << endl;
+                return 1;
+            }
+            if (!setSolverOption(config, key, value, error)) {
+                cerr << "Error: --" << error << endl;
+                return 1;
+            }
+        } else {
+            cerr << "Warning: ignoring unknown option " << arg << endl;
         }
     }
+    if (dumpConfig) {
+        writeSolverConfig(cout, config);
+        return 0;
+    }
+    if (!coordinatorSocket.empty() && coordinatorWorkers < 1) {
+        cerr << "Error: --coordinator requires --workers N" << endl;
+        return 1;
+    }
 
     cout << "\n+========================================================+" << endl;
     cout << "|     PDP SOLVER - GA + TABU SEARCH                  |" << endl;
@@ -70,14 +128,20 @@ int main(int argc, char* argv[]) {
     // Read instance
     cout << "\nReading instance: " << instanceFile << endl;
     PDPData data;
-    data.depotMode = depotMode;
+    data.depotMode = config.depotMode;
     string depotName[] = {"center", "border", "outside"};
-    cout << "Using depot: " << depotName[depotMode] << endl;
+    cout << "Using depot: " << depotName[config.depotMode] << endl;
     
     if (!readPDPFile(instanceFile, data)) {
         cerr << "Error: Failed to read instance file!" << endl;
         return 1;
     }
+    if (config.granularK > 0) {
+        buildNeighborLists(data, config.granularK);
+        cout << "Granular neighborhoods: " << config.granularK << " nearest by truck + drone time ("
+             << fixed << setprecision(1) << (double)data.neighborList.size() / data.numNodes
+             << " candidates per node)" << endl;
+    }
     
     cout << "\nInstance details:" << endl;
     cout << "  Customers: " << data.numCustomers << endl;
@@ -87,8 +151,23 @@ int main(int argc, char* argv[]) {
     cout << "  Depot: (" << data.coordinates[data.depotIndex].first 
          << ", " << data.coordinates[data.depotIndex].second << ")" << endl;
     
-    // Run GA + Tabu
-    PDPSolution solution = geneticAlgorithmPDP(data, populationSize, maxGenerations, mutationRate, runNumber);
+    // Run GA + Tabu, or coordinate the processes that do
+    PDPSolution solution;
+    if (!coordinatorSocket.empty()) {
+        solution = runIslandCoordinator(data, coordinatorSocket, coordinatorWorkers, config.islands.topology);
+        if (!isfinite(solution.totalCost)) {
+            cerr << "Error: no worker reported a solution" << endl;
+            return 1;
+        }
+    } else {
+        // The time limit covers the whole run: reading the instance counts against it
+        SolverConfig gaConfig = config;
+        if (config.timeLimitSec > 0) {
+            double elapsed = chrono::duration<double>(chrono::high_resolution_clock::now() - startTotal).count();
+            gaConfig.timeLimitSec = max(config.timeLimitSec - elapsed, 1e-3);
+        }
+        solution = geneticAlgorithmPDP(data, gaConfig);
+    }
     
     double costBeforeLS = solution.totalCost;
     
@@ -9,6 +9,11 @@
 #include <limits>
 #include <iostream>
 #include <iomanip>
+#include <utility>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 
 using namespace std;
 
@@ -51,68 +56,568 @@ struct SequenceHash {
     }
 };
 
-// Hash for Chromosome: combines sequence + all assignment vectors.
+// Hash for Chromosome: low word of its fingerprint (sequence + all assignment vectors).
+// O(1) when the chromosome carries a precomputed fingerprint (see Chromosome::refreshFingerprint).
 struct ChromosomeHash {
     size_t operator()(const Chromosome& c) const {
-        // Mix element-wise to reduce the chance that different vectors produce same
-        // aggregate hashes. Also inject separators between vectors.
-        size_t seed = 0;
-        hash<int> hasher;
-        auto mixVec = [&](const vector<int>& v, int sep) {
-            SequenceHash::hash_combine(seed, hasher((int)v.size()));
-            SequenceHash::hash_combine(seed, hasher(sep));
-            for (int x : v) {
-                SequenceHash::hash_combine(seed, hasher(x));
+        return (size_t)c.fingerprint().lo;
+    }
+};
+
+// Hash for ChromosomeFingerprint: the low word is already uniformly mixed.
+struct FingerprintHash {
+    size_t operator()(const ChromosomeFingerprint& fp) const {
+        return (size_t)fp.lo;
+    }
+};
+
+/**
+ * @brief Hash table of Key -> Value with CLOCK (second-chance) eviction.
+ *
+ * Entries live in a slot array indexed by an unordered_map, so lookups stay O(1).
+ * A hit sets the slot's reference bit. evictOne() sweeps the clock hand over the
+ * slots, clearing set bits and evicting the first entry whose bit is already
+ * clear, so anything touched since the last sweep survives. Each entry carries
+ * an estimated size in bytes; the owner decides when to evict.
+ *
+ * Thread Safety: NOT thread-safe (lookups update reference bits); SolutionCache
+ * guards each table with its shard's mutex.
+ */
+template <class Key, class Value, class Hash>
+class ClockTable {
+private:
+    struct Slot {
+        const Key* key = nullptr;  // Points at the key stored in `index` (null = free)
+        Value value;
+        size_t bytes = 0;
+    };
+
+    unordered_map<Key, size_t, Hash> index;
+    vector<Slot> slots;
+    mutable vector<uint8_t> refBit;
+    vector<size_t> freeSlots;
+    size_t hand = 0;
+    size_t bytesUsed = 0;
+
+public:
+    /// Approximate fixed cost of one entry (slot + hash node), excluding heap data
+    static constexpr size_t ENTRY_OVERHEAD =
+        sizeof(Slot) + sizeof(uint8_t) + sizeof(pair<const Key, size_t>) + 3 * sizeof(void*);
+
+    /**
+     * @brief Find a cached value and mark it as recently used.
+     * @return Pointer to the value, or nullptr on a miss (valid until the next insert/evict)
+     */
+    const Value* find(const Key& key) const {
+        auto it = index.find(key);
+        if (it == index.end()) {
+            return nullptr;
+        }
+        refBit[it->second] = 1;
+        return &slots[it->second].value;
+    }
+
+    /**
+     * @brief Insert or overwrite an entry; it starts with its reference bit set.
+     * @param entryBytes Estimated heap size of key + value (ENTRY_OVERHEAD is added)
+     */
+    void insert(const Key& key, const Value& value, size_t entryBytes) {
+        entryBytes += ENTRY_OVERHEAD;
+        auto it = index.find(key);
+        if (it != index.end()) {
+            Slot& s = slots[it->second];
+            bytesUsed = bytesUsed - s.bytes + entryBytes;
+            s.value = value;
+            s.bytes = entryBytes;
+            refBit[it->second] = 1;
+            return;
+        }
+
+        size_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = slots.size();
+            slots.emplace_back();
+            refBit.push_back(0);
+        }
+        auto inserted = index.emplace(key, slot).first;
+        Slot& s = slots[slot];
+        s.key = &inserted->first;
+        s.value = value;
+        s.bytes = entryBytes;
+        refBit[slot] = 1;
+        bytesUsed += entryBytes;
+    }
+
+    /**
+     * @brief Evict one entry chosen by the clock hand.
+     * @return Bytes released (0 if the table is empty)
+     */
+    size_t evictOne() {
+        if (index.empty()) {
+            return 0;
+        }
+        // Terminates within two sweeps: the first clears every reference bit
+        while (true) {
+            if (hand >= slots.size()) {
+                hand = 0;
+            }
+            Slot& s = slots[hand];
+            if (s.key == nullptr) {
+                hand++;
+                continue;
+            }
+            if (refBit[hand]) {
+                refBit[hand] = 0;
+                hand++;
+                continue;
             }
-        };
+            size_t released = s.bytes;
+            index.erase(*s.key);
+            s.key = nullptr;
+            s.value = Value();
+            s.bytes = 0;
+            freeSlots.push_back(hand);
+            bytesUsed -= released;
+            hand++;
+            return released;
+        }
+    }
 
-        mixVec(c.sequence, -7);
-        mixVec(c.truck_assign, -11);
-        mixVec(c.drone_assign, -13);
-        mixVec(c.break_bit, -17);
-        return seed;
+    void clear() {
+        index.clear();
+        slots.clear();
+        refBit.clear();
+        freeSlots.clear();
+        hand = 0;
+        bytesUsed = 0;
     }
+
+    size_t size() const { return index.size(); }
+    size_t bytes() const { return bytesUsed; }
 };
 
 /**
- * @brief Solution cache manager with automatic memory management.
+ * @brief Sharded, thread-safe solution cache with a byte budget and CLOCK eviction.
  * 
- * Caches complete PDPSolution objects indexed by customer sequence.
- * Implements a simple cache clearing strategy when memory limit is exceeded.
+ * Caches complete PDPSolution objects (and cost-only PDPCost results) for full
+ * chromosomes. Entries are spread over a power-of-two number of shards by the
+ * high word of the chromosome's fingerprint; each shard has its own mutex, its
+ * own tables, its own slice of the memory budget and its own statistics, which
+ * printStats() / the getters merge. Within a shard, tables are keyed by the
+ * 128-bit fingerprint and store the chromosome next to the value, so a hit is
+ * verified with a full comparison (a fingerprint collision is just a miss).
+ *
+ * When an insert pushes a shard over its budget slice, entries are evicted one
+ * at a time by CLOCK (see ClockTable) from the table that grew, so entries the GA
+ * keeps hitting stay resident instead of the whole cache being dropped at once.
+ *
+ * getOrCompute / getOrComputeCost do lookup, decode and insert in one call. When
+ * several threads miss on the same chromosome, the first one decodes while the
+ * others wait for its result (counted as "in-flight waits"), so a chromosome is
+ * never decoded twice concurrently.
+ *
+ * Compact mode keys a single cost table by the chromosome's 128-bit fingerprint
+ * and keeps only cost / penalty / feasibility, for both put() and putCost().
+ * contains() is then always false, so evaluateWithCache re-decodes whenever a
+ * caller needs routes and events (counted as "re-decodes").
  * 
  * Memory Model:
- * - Each PDPSolution ≈ 10KB for 100-customer problems
- * - MAX_CACHE_SIZE = 150000 entries ≈ 1.5GB RAM
- * - Clearing happens automatically when size threshold exceeded
+ * - Entry size is estimated from vector capacities (key, routes, truck timelines, events)
+ * - A U_100 PDPSolution is ~10-15KB, a cost-only entry ~1.7KB, a compact entry ~90B
+ * - DEFAULT_MEMORY_BUDGET = 1GB; change at runtime with setMemoryBudget()
  * 
- * Thread Safety: NOT thread-safe. Use only from single-threaded GA.
+ * Thread Safety: all member functions may be called concurrently.
  */
 class SolutionCache {
 private:
-    /// Cache storage: sequence -> solution
-    unordered_map<Chromosome, PDPSolution, ChromosomeHash> cache;
-    
-    /// Maximum cache size before automatic clearing
-    static constexpr size_t MAX_CACHE_SIZE = 150000;
-    
-    /// Counter for statistics
-    size_t hits = 0;
-    size_t misses = 0;
-    size_t clears = 0;
+    struct SolutionEntry {
+        Chromosome key;
+        PDPSolution solution;
+    };
+
+    struct CostEntry {
+        Chromosome key;
+        PDPCost cost;
+    };
+
+    /// A decode in progress; threads missing on the same key wait for it
+    struct InFlight {
+        bool done = false;
+        bool failed = false;
+        int waiters = 0;
+        PDPCost cost;
+        PDPSolution solution;  // Filled for full decodes with waiters
+    };
+
+    using PendingMap = unordered_map<ChromosomeFingerprint, shared_ptr<InFlight>, FingerprintHash>;
+
+    struct Shard {
+        mutable mutex lock;
+        condition_variable ready;
+
+        /// Cache storage: chromosome -> solution
+        ClockTable<ChromosomeFingerprint, SolutionEntry, FingerprintHash> cache;
+
+        /// Cost-only storage for screened candidates (see decodeCostOnly)
+        ClockTable<ChromosomeFingerprint, CostEntry, FingerprintHash> costCache;
+
+        /// Compact mode storage: fingerprint -> cost (replaces both tables above)
+        ClockTable<ChromosomeFingerprint, PDPCost, FingerprintHash> compactCache;
+
+        PendingMap pendingCost;
+        PendingMap pendingFull;
+
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t waits = 0;
+        size_t evictions = 0;
+        size_t evictedBytes = 0;
+        size_t redecodes = 0;
+
+        size_t bytes() const {
+            return cache.bytes() + costCache.bytes() + compactCache.bytes();
+        }
+    };
+
+    vector<unique_ptr<Shard>> shards;
+    size_t shardMask;
+    bool compact;
+
+    /// Budget for the estimated footprint of all shards, and each shard's slice of it
+    atomic<size_t> memoryBudget;
+    atomic<size_t> shardBudget;
+
+    /// Counters for callers that do their own lookups (recordHit / recordMiss / recordRedecode)
+    atomic<size_t> extraHits{0};
+    atomic<size_t> extraMisses{0};
+    atomic<size_t> extraRedecodes{0};
+    atomic<size_t> clears{0};
+
+    static size_t vectorBytes(const vector<int>& v) {
+        return v.capacity() * sizeof(int);
+    }
+
+    static size_t chromosomeBytes(const Chromosome& c) {
+        return sizeof(Chromosome) + vectorBytes(c.sequence) + vectorBytes(c.truck_assign) +
+               vectorBytes(c.drone_assign) + vectorBytes(c.break_bit);
+    }
+
+    static size_t solutionBytes(const PDPSolution& s) {
+        size_t bytes = chromosomeBytes(s) + vectorBytes(s.original_sequence);
+        bytes += s.routes.capacity() * sizeof(vector<int>);
+        for (const auto& r : s.routes) {
+            bytes += vectorBytes(r);
+        }
+        bytes += s.truck_details.capacity() * sizeof(TruckRouteInfo);
+        for (const auto& t : s.truck_details) {
+            bytes += vectorBytes(t.route);
+            bytes += (t.arrival_times.capacity() + t.departure_times.capacity()) * sizeof(double);
+        }
+        bytes += s.resupply_events.capacity() * sizeof(ResupplyEvent);
+        for (const auto& e : s.resupply_events) {
+            bytes += vectorBytes(e.customer_ids);
+        }
+        bytes += s.drone_completion_times.capacity() * sizeof(double);
+        return bytes;
+    }
+
+    static PDPCost costOf(const PDPSolution& s) {
+        PDPCost cost;
+        cost.totalCost = s.totalCost;
+        cost.totalPenalty = s.totalPenalty;
+        cost.isFeasible = s.isFeasible;
+        return cost;
+    }
+
+    Shard& shardFor(const ChromosomeFingerprint& fp) const {
+        return *shards[fp.hi & shardMask];
+    }
+
+    // ---- The helpers below expect the shard's lock to be held ----
+
+    /// Evict until the shard is under its budget, preferring `grown`; never evicts the last entry
+    template <class Grown, class Other>
+    void enforceBudget(Shard& s, Grown& grown, Other& other) {
+        size_t budget = shardBudget.load(memory_order_relaxed);
+        while (s.bytes() > budget) {
+            size_t released;
+            if (compact) {
+                if (s.compactCache.size() <= 1) {
+                    break;
+                }
+                released = s.compactCache.evictOne();
+            } else if (grown.size() > 1) {
+                released = grown.evictOne();
+            } else if (other.size() > 0) {
+                released = other.evictOne();
+            } else {
+                break;
+            }
+            s.evictions++;
+            s.evictedBytes += released;
+        }
+    }
+
+    const PDPSolution* findSolutionLocked(const Shard& s, const Chromosome& chromo,
+                                          const ChromosomeFingerprint& fp) const {
+        if (compact) {
+            return nullptr;
+        }
+        const SolutionEntry* e = s.cache.find(fp);
+        return (e != nullptr && e->key == chromo) ? &e->solution : nullptr;
+    }
+
+    bool findCostLocked(const Shard& s, const Chromosome& chromo,
+                        const ChromosomeFingerprint& fp, PDPCost& out) const {
+        if (compact) {
+            const PDPCost* cost = s.compactCache.find(fp);
+            if (cost == nullptr) {
+                return false;
+            }
+            out = *cost;
+            return true;
+        }
+        const PDPSolution* sol = findSolutionLocked(s, chromo, fp);
+        if (sol != nullptr) {
+            out = costOf(*sol);
+            return true;
+        }
+        const CostEntry* e = s.costCache.find(fp);
+        if (e != nullptr && e->key == chromo) {
+            out = e->cost;
+            return true;
+        }
+        return false;
+    }
+
+    void putCostLocked(Shard& s, const Chromosome& chromo,
+                       const ChromosomeFingerprint& fp, const PDPCost& cost) {
+        if (compact) {
+            s.compactCache.insert(fp, cost, 0);
+            enforceBudget(s, s.compactCache, s.compactCache);
+            return;
+        }
+        s.costCache.insert(fp, CostEntry{chromo, cost}, chromosomeBytes(chromo));
+        enforceBudget(s, s.costCache, s.cache);
+    }
+
+    void putLocked(Shard& s, const Chromosome& chromo,
+                   const ChromosomeFingerprint& fp, const PDPSolution& solution) {
+        if (compact) {
+            putCostLocked(s, chromo, fp, costOf(solution));
+            return;
+        }
+        s.cache.insert(fp, SolutionEntry{chromo, solution}, chromosomeBytes(chromo) + solutionBytes(solution));
+        enforceBudget(s, s.cache, s.costCache);
+    }
+
+    /// Wait for an in-flight decode of the same key; false if its owner failed
+    static bool waitFor(Shard& s, unique_lock<mutex>& guard, const shared_ptr<InFlight>& job) {
+        job->waiters++;
+        s.ready.wait(guard, [&] { return job->done; });
+        return !job->failed;
+    }
+
+    /// Owner could not compute: release waiters (they retry themselves)
+    static void abandon(Shard& s, PendingMap& pending, const ChromosomeFingerprint& fp,
+                        const shared_ptr<InFlight>& job) {
+        {
+            lock_guard<mutex> guard(s.lock);
+            job->failed = true;
+            job->done = true;
+            pending.erase(fp);
+        }
+        s.ready.notify_all();
+    }
+
+    template <class F>
+    size_t sumShards(F f) const {
+        size_t total = 0;
+        for (const auto& s : shards) {
+            lock_guard<mutex> guard(s->lock);
+            total += f(*s);
+        }
+        return total;
+    }
 
 public:
+    /// Default memory budget (bytes) for all tables together
+    static constexpr size_t DEFAULT_MEMORY_BUDGET = size_t(1) << 30;
+
+    /// Default shard count (rounded up to a power of two)
+    static constexpr size_t DEFAULT_SHARDS = 16;
+
     /**
      * @brief Construct an empty cache.
+     * @param budgetBytes Memory budget for cached entries (0 = DEFAULT_MEMORY_BUDGET)
+     * @param compactMode Store fingerprint -> cost only (see class comment)
+     * @param numShards Number of independently locked shards (rounded up to a power of two)
      */
-    SolutionCache() = default;
+    explicit SolutionCache(size_t budgetBytes = DEFAULT_MEMORY_BUDGET, bool compactMode = false,
+                           size_t numShards = DEFAULT_SHARDS)
+        : compact(compactMode), memoryBudget(0), shardBudget(0) {
+        size_t count = 1;
+        while (count < numShards) {
+            count <<= 1;
+        }
+        shards.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            shards.push_back(unique_ptr<Shard>(new Shard()));
+        }
+        shardMask = count - 1;
+        setMemoryBudget(budgetBytes);
+    }
+
+    SolutionCache(const SolutionCache&) = delete;
+    SolutionCache& operator=(const SolutionCache&) = delete;
+
+    bool isCompact() const {
+        return compact;
+    }
+
+    size_t shardCount() const {
+        return shards.size();
+    }
+
+    /**
+     * @brief Cached solution for `chromo`, or compute() it (once, even under contention) and cache it.
+     * In compact mode the result is always computed; a known chromosome counts as a re-decode.
+     * @param compute Callable returning the PDPSolution of `chromo` (e.g. a decodeFromEncoding lambda)
+     */
+    template <class Compute>
+    PDPSolution getOrCompute(const Chromosome& chromo, Compute&& compute) {
+        ChromosomeFingerprint fp = chromo.fingerprint();
+        Shard& s = shardFor(fp);
+        unique_lock<mutex> guard(s.lock);
+
+        if (compact) {
+            PDPCost known;
+            bool isKnown = findCostLocked(s, chromo, fp, known);
+            if (isKnown) s.redecodes++;
+            else s.misses++;
+            guard.unlock();
+            PDPSolution solution = compute();
+            if (!isKnown) {
+                guard.lock();
+                putLocked(s, chromo, fp, solution);
+            }
+            return solution;
+        }
+
+        shared_ptr<InFlight> job;
+        while (true) {
+            const PDPSolution* sol = findSolutionLocked(s, chromo, fp);
+            if (sol != nullptr) {
+                s.hits++;
+                return *sol;
+            }
+            auto it = s.pendingFull.find(fp);
+            if (it == s.pendingFull.end()) {
+                break;
+            }
+            job = it->second;
+            if (waitFor(s, guard, job)) {
+                s.hits++;
+                s.waits++;
+                return job->solution;
+            }
+        }
+
+        s.misses++;
+        job = make_shared<InFlight>();
+        s.pendingFull[fp] = job;
+        guard.unlock();
+
+        PDPSolution solution;
+        try {
+            solution = compute();
+        } catch (...) {
+            abandon(s, s.pendingFull, fp, job);
+            throw;
+        }
+
+        guard.lock();
+        putLocked(s, chromo, fp, solution);
+        job->cost = costOf(solution);
+        if (job->waiters > 0) {
+            job->solution = solution;
+        }
+        job->done = true;
+        s.pendingFull.erase(fp);
+        guard.unlock();
+        s.ready.notify_all();
+        return solution;
+    }
+
+    /**
+     * @brief Cost-only counterpart of getOrCompute (answers from either table).
+     * @param compute Callable returning the PDPCost of `chromo` (e.g. a decodeCostOnly lambda)
+     */
+    template <class Compute>
+    PDPCost getOrComputeCost(const Chromosome& chromo, Compute&& compute) {
+        ChromosomeFingerprint fp = chromo.fingerprint();
+        Shard& s = shardFor(fp);
+        unique_lock<mutex> guard(s.lock);
+
+        shared_ptr<InFlight> job;
+        while (true) {
+            PDPCost cost;
+            if (findCostLocked(s, chromo, fp, cost)) {
+                s.hits++;
+                return cost;
+            }
+            auto it = s.pendingCost.find(fp);
+            if (it == s.pendingCost.end()) {
+                it = s.pendingFull.find(fp);
+                if (it == s.pendingFull.end()) {
+                    break;
+                }
+            }
+            job = it->second;
+            if (waitFor(s, guard, job)) {
+                s.hits++;
+                s.waits++;
+                return job->cost;
+            }
+        }
+
+        s.misses++;
+        job = make_shared<InFlight>();
+        s.pendingCost[fp] = job;
+        guard.unlock();
+
+        PDPCost cost;
+        try {
+            cost = compute();
+        } catch (...) {
+            abandon(s, s.pendingCost, fp, job);
+            throw;
+        }
+
+        guard.lock();
+        putCostLocked(s, chromo, fp, cost);
+        job->cost = cost;
+        job->done = true;
+        s.pendingCost.erase(fp);
+        guard.unlock();
+        s.ready.notify_all();
+        return cost;
+    }
 
     /**
      * @brief Check if a sequence is in cache.
+     * Always false in compact mode (no solution details are kept).
      * @param seq Customer sequence
      * @return true if sequence is cached
      */
     bool contains(const Chromosome& chromo) const {
-        return cache.find(chromo) != cache.end();
+        ChromosomeFingerprint fp = chromo.fingerprint();
+        const Shard& s = shardFor(fp);
+        lock_guard<mutex> guard(s.lock);
+        return findSolutionLocked(s, chromo, fp) != nullptr;
     }
 
     // Backward-compatible overload: cache by sequence only (empty assignments).
@@ -122,6 +627,22 @@ public:
         return contains(c);
     }
 
+    /**
+     * @brief Single-lookup contains() + get().
+     * @return true and copies the cached solution into `out` if present
+     */
+    bool tryGet(const Chromosome& chromo, PDPSolution& out) const {
+        ChromosomeFingerprint fp = chromo.fingerprint();
+        const Shard& s = shardFor(fp);
+        lock_guard<mutex> guard(s.lock);
+        const PDPSolution* sol = findSolutionLocked(s, chromo, fp);
+        if (sol == nullptr) {
+            return false;
+        }
+        out = *sol;
+        return true;
+    }
+
     /**
      * @brief Retrieve a cached solution.
      * Assumes the sequence is in cache. Use contains() to check first.
@@ -129,12 +650,10 @@ public:
      * @return Copy of the cached PDPSolution
      */
     PDPSolution get(const Chromosome& chromo) const {
-        auto it = cache.find(chromo);
-        if (it != cache.end()) {
-            return it->second;
-        }
-        // Should not reach here if contains() was checked
-        return PDPSolution();
+        PDPSolution sol;
+        tryGet(chromo, sol);
+        // Default-constructed if not cached (contains() should be checked first)
+        return sol;
     }
 
     // Backward-compatible overload: cache by sequence only (empty assignments).
@@ -146,18 +665,15 @@ public:
 
     /**
      * @brief Store a solution in cache.
-     * Automatically clears cache if size exceeds MAX_CACHE_SIZE.
+     * Evicts least recently used entries (CLOCK) while the shard is over budget.
      * @param seq Customer sequence (key)
      * @param solution Complete PDPSolution (value)
      */
     void put(const Chromosome& chromo, const PDPSolution& solution) {
-        cache[chromo] = solution;
-        
-        // Check memory management: if cache exceeds limit, clear all
-        if (cache.size() >= MAX_CACHE_SIZE) {
-            cache.clear();
-            clears++;
-        }
+        ChromosomeFingerprint fp = chromo.fingerprint();
+        Shard& s = shardFor(fp);
+        lock_guard<mutex> guard(s.lock);
+        putLocked(s, chromo, fp, solution);
     }
 
     // Backward-compatible overload: cache by sequence only (empty assignments).
@@ -167,21 +683,76 @@ public:
         put(c, solution);
     }
 
+    /**
+     * @brief Look up the objective values of a chromosome.
+     * Full solutions answer cost queries too, so both tables are checked.
+     * @return true and fills `out` if the chromosome is cached
+     */
+    bool findCost(const Chromosome& chromo, PDPCost& out) const {
+        ChromosomeFingerprint fp = chromo.fingerprint();
+        const Shard& s = shardFor(fp);
+        lock_guard<mutex> guard(s.lock);
+        return findCostLocked(s, chromo, fp, out);
+    }
+
+    /**
+     * @brief Store the objective values of a chromosome (no solution details).
+     * Shares the memory budget with the solution table.
+     */
+    void putCost(const Chromosome& chromo, const PDPCost& cost) {
+        ChromosomeFingerprint fp = chromo.fingerprint();
+        Shard& s = shardFor(fp);
+        lock_guard<mutex> guard(s.lock);
+        putCostLocked(s, chromo, fp, cost);
+    }
+
     /**
      * @brief Manually clear all cached solutions.
      * Useful if memory needs to be freed or cache is corrupted.
+     * Decodes in flight still complete and insert their result.
      */
     void clear() {
-        cache.clear();
+        for (auto& s : shards) {
+            lock_guard<mutex> guard(s->lock);
+            s->cache.clear();
+            s->costCache.clear();
+            s->compactCache.clear();
+        }
         clears++;
     }
 
+    /**
+     * @brief Change the memory budget; evicts immediately if the cache is over it.
+     * @param budgetBytes New budget in bytes (0 = DEFAULT_MEMORY_BUDGET)
+     */
+    void setMemoryBudget(size_t budgetBytes) {
+        size_t budget = budgetBytes > 0 ? budgetBytes : DEFAULT_MEMORY_BUDGET;
+        memoryBudget = budget;
+        shardBudget = max<size_t>(1, budget / shards.size());
+        for (auto& s : shards) {
+            lock_guard<mutex> guard(s->lock);
+            enforceBudget(*s, s->costCache, s->cache);
+            enforceBudget(*s, s->cache, s->costCache);
+        }
+    }
+
+    size_t getMemoryBudget() const {
+        return memoryBudget;
+    }
+
+    /**
+     * @brief Estimated bytes held by all tables.
+     */
+    size_t memoryUsed() const {
+        return sumShards([](const Shard& s) { return s.bytes(); });
+    }
+
     /**
      * @brief Get current number of entries in cache.
      * @return Number of cached solutions
      */
     size_t size() const {
-        return cache.size();
+        return sumShards([](const Shard& s) { return s.cache.size(); });
     }
 
     /**
@@ -189,7 +760,7 @@ public:
      * @return Number of successful cache hits since initialization
      */
     size_t getHits() const {
-        return hits;
+        return extraHits + sumShards([](const Shard& s) { return s.hits; });
     }
 
     /**
@@ -197,46 +768,108 @@ public:
      * @return Number of cache misses since initialization
      */
     size_t getMisses() const {
-        return misses;
+        return extraMisses + sumShards([](const Shard& s) { return s.misses; });
     }
 
     /**
      * @brief Get number of times cache was cleared.
-     * @return Number of automatic cache clears
+     * @return Number of manual clear() calls
      */
     size_t getClears() const {
         return clears;
     }
 
+    /**
+     * @brief Get number of entries evicted to stay within the memory budget.
+     */
+    size_t getEvictions() const {
+        return sumShards([](const Shard& s) { return s.evictions; });
+    }
+
+    /**
+     * @brief Number of full solutions re-decoded in compact mode although their cost was cached.
+     */
+    size_t getRedecodes() const {
+        return extraRedecodes + sumShards([](const Shard& s) { return s.redecodes; });
+    }
+
+    /**
+     * @brief Number of misses answered by waiting for another thread's decode of the same key.
+     */
+    size_t getInFlightWaits() const {
+        return sumShards([](const Shard& s) { return s.waits; });
+    }
+
     /**
      * @brief Record a cache hit.
-     * Called internally by evaluateWithCache.
+     * For callers doing their own lookups; getOrCompute counts per shard.
      */
     void recordHit() {
-        hits++;
+        extraHits++;
     }
 
     /**
      * @brief Record a cache miss.
-     * Called internally by evaluateWithCache.
+     * For callers doing their own lookups; getOrCompute counts per shard.
      */
     void recordMiss() {
-        misses++;
+        extraMisses++;
     }
 
     /**
-     * @brief Print cache statistics to console.
+     * @brief Record a compact-mode cost hit that still needed a full decode.
+     * For callers doing their own lookups; getOrCompute counts per shard.
+     */
+    void recordRedecode() {
+        extraRedecodes++;
+    }
+
+    /**
+     * @brief Print cache statistics (merged over all shards) to console.
      */
     void printStats() const {
+        size_t hits = extraHits, misses = extraMisses, redecodes = extraRedecodes;
+        size_t waits = 0, evictions = 0, evictedBytes = 0, bytes = 0;
+        size_t entries = 0, costEntries = 0, largestShard = 0;
+        for (const auto& s : shards) {
+            lock_guard<mutex> guard(s->lock);
+            hits += s->hits;
+            misses += s->misses;
+            redecodes += s->redecodes;
+            waits += s->waits;
+            evictions += s->evictions;
+            evictedBytes += s->evictedBytes;
+            bytes += s->bytes();
+            size_t shardEntries = compact ? s->compactCache.size() : s->cache.size() + s->costCache.size();
+            largestShard = max(largestShard, shardEntries);
+            entries += compact ? s->compactCache.size() : s->cache.size();
+            costEntries += s->costCache.size();
+        }
+
         size_t total = hits + misses;
         double hitRate = (total > 0) ? (100.0 * hits / total) : 0.0;
+        const double MB = 1024.0 * 1024.0;
         cout << "\n[CACHE STATS]" << endl;
-        cout << "  Current size: " << cache.size() << " entries" << endl;
+        if (compact) {
+            cout << "  Mode: compact (fingerprint -> cost)" << endl;
+            cout << "  Current size: " << entries << " entries" << endl;
+        } else {
+            cout << "  Current size: " << entries << " entries" << endl;
+            cout << "  Cost-only entries: " << costEntries << endl;
+        }
+        cout << "  Shards: " << shards.size() << " (largest: " << largestShard << " entries)" << endl;
+        cout << "  Memory: " << fixed << setprecision(1) << bytes / MB
+             << " MB of " << memoryBudget / MB << " MB budget" << endl;
         cout << "  Hits: " << hits << endl;
         cout << "  Misses: " << misses << endl;
         cout << "  Total accesses: " << total << endl;
         cout << "  Hit rate: " << fixed << setprecision(2) << hitRate << "%" << endl;
-        cout << "  Auto-clears: " << clears << endl;
+        cout << "  In-flight waits: " << waits << endl;
+        if (compact) {
+            cout << "  Re-decodes for details: " << redecodes << endl;
+        }
+        cout << "  Evictions: " << evictions << " (" << setprecision(1) << evictedBytes / MB << " MB)" << endl;
+        cout << "  Manual clears: " << clears << endl;
     }
 };
 
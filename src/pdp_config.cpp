@@ -0,0 +1,347 @@
+#include "pdp_config.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <functional>
+#include <cctype>
+#include <climits>
+
+using namespace std;
+
+// ============ VALUE PARSING ============
+
+// Whole-string parses: trailing characters make the value invalid
+static bool parseInt(const string& text, int minValue, int& out) {
+    istringstream in(text);
+    int value;
+    if (!(in >> value) || value < minValue) return false;
+    in >> ws;
+    if (!in.eof()) return false;
+    out = value;
+    return true;
+}
+
+static bool parseDouble(const string& text, double minValue, double maxValue, double& out) {
+    istringstream in(text);
+    double value;
+    if (!(in >> value) || !(value >= minValue && value <= maxValue)) return false;
+    in >> ws;
+    if (!in.eof()) return false;
+    out = value;
+    return true;
+}
+
+static bool parseBool(const string& text, bool& out) {
+    if (text == "1" || text == "true" || text == "yes" || text == "on") {
+        out = true;
+    } else if (text == "0" || text == "false" || text == "no" || text == "off") {
+        out = false;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static string formatDouble(double value) {
+    ostringstream out;
+    out << setprecision(10) << value;
+    return out.str();
+}
+
+// ============ OPTION TABLE ============
+
+struct SolverOption {
+    const char* key;
+    const char* requirement;   // Error text for an invalid value
+    function<bool(SolverConfig&, const string&)> set;
+    function<string(const SolverConfig&)> get;   // "" = not written (aliases, unset)
+};
+
+static const vector<SolverOption>& solverOptions() {
+    static const vector<SolverOption> options = {
+        {"population", "population N must be a positive integer",
+         [](SolverConfig& c, const string& v) { return parseInt(v, 1, c.populationSize); },
+         [](const SolverConfig& c) { return to_string(c.populationSize); }},
+        {"generations", "generations N must be a positive integer",
+         [](SolverConfig& c, const string& v) { return parseInt(v, 1, c.maxGenerations); },
+         [](const SolverConfig& c) { return to_string(c.maxGenerations); }},
+        {"mutation-rate", "mutation-rate R must be in [0, 1]",
+         [](SolverConfig& c, const string& v) { return parseDouble(v, 0.0, 1.0, c.mutationRate); },
+         [](const SolverConfig& c) { return formatDouble(c.mutationRate); }},
+        {"run", "run N must be an integer",
+         [](SolverConfig& c, const string& v) { return parseInt(v, INT_MIN, c.runNumber); },
+         [](const SolverConfig& c) { return to_string(c.runNumber); }},
+        {"seed", "seed N must be a non-negative integer (-1 = random)",
+         [](SolverConfig& c, const string& v) { return parseInt(v, -1, c.seed); },
+         [](const SolverConfig& c) { return to_string(c.seed); }},
+        {"elite-decode-share", "elite-decode-share S must be in (0, 1]",
+         [](SolverConfig& c, const string& v) {
+             double share;
+             if (!parseDouble(v, 0.0, 1.0, share) || share <= 0.0) return false;
+             c.eliteDecodeShare = share;
+             return true;
+         },
+         [](const SolverConfig& c) { return formatDouble(c.eliteDecodeShare); }},
+        {"explore-decode-share", "explore-decode-share S must be in [0, 1]",
+         [](SolverConfig& c, const string& v) { return parseDouble(v, 0.0, 1.0, c.exploreDecodeShare); },
+         [](const SolverConfig& c) { return formatDouble(c.exploreDecodeShare); }},
+        {"tabu-threshold", "tabu-threshold N must be a non-negative integer (0 = auto)",
+         [](SolverConfig& c, const string& v) { return parseInt(v, 0, c.tabuThreshold); },
+         [](const SolverConfig& c) { return to_string(c.tabuThreshold); }},
+        {"tabu-iterations", "tabu-iterations N must be a positive integer",
+         [](SolverConfig& c, const string& v) { return parseInt(v, 1, c.tabuIterations); },
+         [](const SolverConfig& c) { return to_string(c.tabuIterations); }},
+        {"ls-starts", "ls-starts N must be a non-negative integer (0 = auto)",
+         [](SolverConfig& c, const string& v) {
+             int starts;
+             if (!parseInt(v, 0, starts)) return false;
+             c.tabuLSStarts = c.finalLSStarts = starts;
+             return true;
+         },
+         [](const SolverConfig&) { return string(); }},
+        {"tabu-ls-starts", "tabu-ls-starts N must be a non-negative integer (0 = auto)",
+         [](SolverConfig& c, const string& v) { return parseInt(v, 0, c.tabuLSStarts); },
+         [](const SolverConfig& c) { return to_string(c.tabuLSStarts); }},
+        {"final-ls-starts", "final-ls-starts N must be a non-negative integer (0 = auto)",
+         [](SolverConfig& c, const string& v) { return parseInt(v, 0, c.finalLSStarts); },
+         [](const SolverConfig& c) { return to_string(c.finalLSStarts); }},
+        {"ls-iterations", "ls-iterations N must be a positive integer",
+         [](SolverConfig& c, const string& v) { return parseInt(v, 1, c.lsIterations); },
+         [](const SolverConfig& c) { return to_string(c.lsIterations); }},
+        {"cache-mb", "cache-mb MB must be a non-negative integer (0 = default)",
+         [](SolverConfig& c, const string& v) {
+             int cacheMB;
+             if (!parseInt(v, 0, cacheMB)) return false;
+             c.cacheBudgetBytes = (size_t)cacheMB * 1024 * 1024;
+             return true;
+         },
+         [](const SolverConfig& c) { return to_string(c.cacheBudgetBytes / (1024 * 1024)); }},
+        {"cache-compact", "cache-compact must be true or false",
+         [](SolverConfig& c, const string& v) { return parseBool(v, c.compactCache); },
+         [](const SolverConfig& c) { return string(c.compactCache ? "true" : "false"); }},
+        {"threads", "threads N must be a non-negative integer (0 = all cores)",
+         [](SolverConfig& c, const string& v) { return parseInt(v, 0, c.numThreads); },
+         [](const SolverConfig& c) { return to_string(c.numThreads); }},
+        {"islands", "islands K must be a positive integer",
+         [](SolverConfig& c, const string& v) { return parseInt(v, 1, c.islands.islands); },
+         [](const SolverConfig& c) { return to_string(c.islands.islands); }},
+        {"migration-interval", "migration-interval G must be a positive integer",
+         [](SolverConfig& c, const string& v) { return parseInt(v, 1, c.islands.migrationInterval); },
+         [](const SolverConfig& c) { return to_string(c.islands.migrationInterval); }},
+        {"migrants", "migrants M must be a non-negative integer",
+         [](SolverConfig& c, const string& v) { return parseInt(v, 0, c.islands.migrants); },
+         [](const SolverConfig& c) { return to_string(c.islands.migrants); }},
+        {"topology", "topology must be ring or random",
+         [](SolverConfig& c, const string& v) {
+             if (v == "ring") {
+                 c.islands.topology = MIGRATION_RING;
+             } else if (v == "random") {
+                 c.islands.topology = MIGRATION_RANDOM;
+             } else {
+                 return false;
+             }
+             return true;
+         },
+         [](const SolverConfig& c) { return string(c.islands.topology == MIGRATION_RANDOM ? "random" : "ring"); }},
+        {"join", "join SOCKET must not be empty",
+         [](SolverConfig& c, const string& v) {
+             if (v.empty()) return false;
+             c.islands.coordinatorSocket = v;
+             return true;
+         },
+         [](const SolverConfig& c) { return c.islands.coordinatorSocket; }},
+        {"time-limit", "time-limit SECONDS must be a non-negative number (0 = none)",
+         [](SolverConfig& c, const string& v) { return parseDouble(v, 0.0, 1e12, c.timeLimitSec); },
+         [](const SolverConfig& c) { return formatDouble(c.timeLimitSec); }},
+        {"final-ls-time-share", "final-ls-time-share S must be in [0, 1)",
+         [](SolverConfig& c, const string& v) {
+             double share;
+             if (!parseDouble(v, 0.0, 1.0, share) || share >= 1.0) return false;
+             c.finalLSTimeShare = share;
+             return true;
+         },
+         [](const SolverConfig& c) { return formatDouble(c.finalLSTimeShare); }},
+        {"depot", "depot MODE must be 0 (center), 1 (border), or 2 (outside)",
+         [](SolverConfig& c, const string& v) {
+             int mode;
+             if (!parseInt(v, 0, mode) || mode > 2) return false;
+             c.depotMode = mode;
+             return true;
+         },
+         [](const SolverConfig& c) { return to_string(c.depotMode); }},
+        {"granular", "granular K must be a non-negative integer (0 = off)",
+         [](SolverConfig& c, const string& v) { return parseInt(v, 0, c.granularK); },
+         [](const SolverConfig& c) { return to_string(c.granularK); }},
+    };
+    return options;
+}
+
+// Lower case, '_' -> '-', and aliases resolved
+static string normalizeKey(const string& key) {
+    string name;
+    for (char ch : key) {
+        name += ch == '_' ? '-' : (char)tolower((unsigned char)ch);
+    }
+    if (name == "time") name = "time-limit";   // benchmark scripts pass --time
+    return name;
+}
+
+static const SolverOption* findOption(const string& key) {
+    string name = normalizeKey(key);
+    for (const SolverOption& option : solverOptions()) {
+        if (name == option.key) return &option;
+    }
+    return nullptr;
+}
+
+bool hasSolverOption(const string& key) {
+    return findOption(key) != nullptr;
+}
+
+bool isSolverSwitch(const string& key) {
+    return normalizeKey(key) == "cache-compact";
+}
+
+bool setSolverOption(SolverConfig& config, const string& key, const string& value, string& error) {
+    const SolverOption* option = findOption(key);
+    if (!option) {
+        error = "unknown option " + key;
+        return false;
+    }
+    SolverConfig updated = config;
+    if (!option->set(updated, value)) {
+        error = option->requirement;
+        return false;
+    }
+    config = updated;
+    return true;
+}
+
+void writeSolverConfig(ostream& out, const SolverConfig& config) {
+    for (const SolverOption& option : solverOptions()) {
+        string value = option.get(config);
+        if (!value.empty()) out << option.key << "=" << value << "\n";
+    }
+}
+
+// ============ CONFIG FILES ============
+
+static string trim(const string& text) {
+    size_t begin = text.find_first_not_of(" \t\r\n");
+    if (begin == string::npos) return "";
+    size_t end = text.find_last_not_of(" \t\r\n");
+    return text.substr(begin, end - begin + 1);
+}
+
+static int lineAt(const string& text, size_t pos) {
+    int line = 1;
+    for (size_t i = 0; i < pos && i < text.size(); ++i) {
+        if (text[i] == '\n') line++;
+    }
+    return line;
+}
+
+static bool loadKeyValueConfig(const string& text, const string& path, SolverConfig& config,
+                               string& error) {
+    istringstream in(text);
+    string line;
+    for (int lineNo = 1; getline(in, line); ++lineNo) {
+        size_t comment = line.find('#');
+        if (comment != string::npos) line.erase(comment);
+        line = trim(line);
+        if (line.empty()) continue;
+
+        size_t eq = line.find('=');
+        string reason;
+        if (eq == string::npos) {
+            reason = "expected key=value";
+        } else if (setSolverOption(config, trim(line.substr(0, eq)), trim(line.substr(eq + 1)), reason)) {
+            continue;
+        }
+        error = path + ":" + to_string(lineNo) + ": " + reason;
+        return false;
+    }
+    return true;
+}
+
+// Flat JSON object: string keys; string, number or true/false values
+static bool loadJsonConfig(const string& text, const string& path, SolverConfig& config,
+                           string& error) {
+    size_t pos = 0;
+    auto skipSpace = [&]() {
+        while (pos < text.size() && isspace((unsigned char)text[pos])) pos++;
+    };
+    auto fail = [&](const string& reason) {
+        error = path + ":" + to_string(lineAt(text, pos)) + ": " + reason;
+        return false;
+    };
+    auto readString = [&](string& out) {
+        // pos is on the opening quote
+        out.clear();
+        for (pos++; pos < text.size() && text[pos] != '"'; pos++) {
+            if (text[pos] == '\\' && pos + 1 < text.size()) pos++;
+            out += text[pos];
+        }
+        if (pos >= text.size()) return false;
+        pos++;
+        return true;
+    };
+
+    skipSpace();
+    if (pos >= text.size() || text[pos] != '{') return fail("expected '{'");
+    pos++;
+    skipSpace();
+    if (pos < text.size() && text[pos] == '}') return true;
+
+    while (true) {
+        skipSpace();
+        string key, value;
+        if (pos >= text.size() || text[pos] != '"' || !readString(key)) return fail("expected a quoted key");
+        skipSpace();
+        if (pos >= text.size() || text[pos] != ':') return fail("expected ':' after \"" + key + "\"");
+        pos++;
+        skipSpace();
+        if (pos < text.size() && text[pos] == '"') {
+            if (!readString(value)) return fail("unterminated string");
+        } else if (pos < text.size() && (text[pos] == '{' || text[pos] == '[')) {
+            return fail("\"" + key + "\": nested values are not supported");
+        } else {
+            size_t end = text.find_first_of(",}\n", pos);
+            if (end == string::npos) end = text.size();
+            value = trim(text.substr(pos, end - pos));
+            pos = end;
+        }
+        string reason;
+        if (!setSolverOption(config, key, value, reason)) return fail(reason);
+
+        skipSpace();
+        if (pos < text.size() && text[pos] == ',') {
+            pos++;
+        } else if (pos < text.size() && text[pos] == '}') {
+            return true;
+        } else {
+            return fail("expected ',' or '}'");
+        }
+    }
+}
+
+bool loadSolverConfig(const string& path, SolverConfig& config, string& error) {
+    ifstream file(path);
+    if (!file) {
+        error = "cannot read config file " + path;
+        return false;
+    }
+    stringstream buffer;
+    buffer << file.rdbuf();
+    string text = buffer.str();
+
+    // All or nothing: a bad entry leaves config as it was
+    SolverConfig loaded = config;
+    string body = trim(text);
+    bool ok = (!body.empty() && body[0] == '{')
+                  ? loadJsonConfig(text, path, loaded, error)
+                  : loadKeyValueConfig(text, path, loaded, error);
+    if (ok) config = loaded;
+    return ok;
+}
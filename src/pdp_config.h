@@ -0,0 +1,42 @@
+#ifndef PDP_CONFIG_H
+#define PDP_CONFIG_H
+
+#include "pdp_ga.h"
+#include <string>
+#include <ostream>
+
+// ============ SOLVER CONFIGURATION ============
+// Options are named like the command-line flags without "--" (population,
+// tabu-iterations, ls-starts, ...); '_' is accepted for '-'. The same names are
+// used on the command line, in key=value files and in JSON files.
+
+// true if key names a SolverConfig option
+bool hasSolverOption(const std::string& key);
+
+// true if the option is a switch that needs no value on the command line (cache-compact)
+bool isSolverSwitch(const std::string& key);
+
+/**
+ * @brief Set one option from its text value.
+ * @param[out] error Reason when the key is unknown or the value is invalid
+ * @return false (config unchanged) on error
+ */
+bool setSolverOption(SolverConfig& config, const std::string& key, const std::string& value,
+                     std::string& error);
+
+/**
+ * @brief Apply the options of a config file on top of config.
+ *
+ * Two formats, told apart by the first non-blank character:
+ * - key=value lines; '#' starts a comment, blank lines are skipped
+ * - a flat JSON object: {"population": 300, "topology": "random", "cache-compact": true}
+ *
+ * @param[out] error "path:line: reason" for the first bad entry
+ * @return false if the file cannot be read or has a bad entry
+ */
+bool loadSolverConfig(const std::string& path, SolverConfig& config, std::string& error);
+
+// Write every option as key=value lines (readable back by loadSolverConfig)
+void writeSolverConfig(std::ostream& out, const SolverConfig& config);
+
+#endif // PDP_CONFIG_H
@@ -12,152 +12,111 @@
 
 using namespace std;
 
-// ============ FORWARD DECLARATIONS ============
-
-// Trang thai cua moi xe tai (dung chung cho nhieu functions)
-struct TruckState {
-    double available_time;      // Thoi diem xe ranh
-    int current_position;       // Vi tri hien tai cua xe
-    double current_load;        // Load hien tai
-    vector<int> route;          // Route cua xe nay
-    vector<double> arrival_times;   // Thoi gian den moi node
-    vector<double> departure_times; // Thoi gian roi moi node
-    set<int> picked_up_pairs;   // Cac cap P-DL da pickup (luu pairId)
-    set<int> cargo_on_truck;    // Cac goi hang dang co tren xe (customer IDs)
-};
-
 // ============ UTILITY FUNCTIONS ============
 
 // Ham tien ich cho truck (Manhattan)
-static double getTruckDistance(const PDPData& data, int nodeA_id, int nodeB_id) {
-    if (nodeA_id < 0 || nodeA_id >= data.numNodes || nodeB_id < 0 || nodeB_id >= data.numNodes) 
-        return numeric_limits<double>::infinity();
-    return data.truckDistMatrix[nodeA_id][nodeB_id];
+// Unchecked: the decoder only sees node ids taken from the instance.
+static inline double getTruckDistance(const PDPData& data, int nodeA_id, int nodeB_id) {
+    return data.truckDistMatrix.at(nodeA_id, nodeB_id);
 }
 
 // Ham tien ich cho drone (Euclidean)
-static double getDroneDistance(const PDPData& data, int nodeA_id, int nodeB_id) {
-    if (nodeA_id < 0 || nodeA_id >= data.numNodes || nodeB_id < 0 || nodeB_id >= data.numNodes) 
-        return numeric_limits<double>::infinity();
-    return data.droneDistMatrix[nodeA_id][nodeB_id];
+static inline double getDroneDistance(const PDPData& data, int nodeA_id, int nodeB_id) {
+    return data.droneDistMatrix.at(nodeA_id, nodeB_id);
 }
 
-// ============ DRONE CONSOLIDATION HELPER ============
+// Travel-time views of one decode. The storage width of each matrix is resolved once
+// by withTravelTimes, so the per-leg lookups of the decoder do not branch on it.
+template <typename TruckCell, typename DroneCell>
+struct TravelTimes {
+    TravelTimeMatrix::View<TruckCell> truck;
+    TravelTimeMatrix::View<DroneCell> drone;
+};
 
-// Forward declaration
-static pair<double, bool> evaluateDroneTrip(
-    const vector<int>& customers,
-    int drone_id,
-    const struct TruckState& truck,
-    const PDPData& data,
-    const vector<double>& Drone_Available_Time
-);
+template <typename TruckCell, typename DroneCell>
+static inline double getTruckDistance(const TravelTimes<TruckCell, DroneCell>& tt, int nodeA_id, int nodeB_id) {
+    return tt.truck.at(nodeA_id, nodeB_id);
+}
 
-/**
- * @brief Tinh toan chi phi va kiem tra feasibility cua drone trip
- * LOGIC CHINH XAC:
- *   1. Drone xuat phat tu DEPOT (mang nhieu goi hang - packages cho customers)
- *   2. Drone bay THANG den 1 DIEM GAP TRUCK (resupply point - la 1 customer nao do)
- *   3. Tai diem do, drone GIAO TAT CA packages cho truck
- *   4. Drone ve depot
- *   5. Truck se di giao hang cho cac customers
- * 
- * @param customers Danh sach customer IDs ma packages cua ho duoc chuyen cho truck (KHONG phai drone visit)
- * @param drone_id ID cua drone
- * @param truck Trang thai hien tai cua truck
- * @param data Du lieu bai toan
- * @param Drone_Available_Time Vector thoi gian ranh cua cac drones
- * @return pair<completion_time, feasible>
- */
-static pair<double, bool> evaluateDroneTrip(
-    const vector<int>& customers,
-    int drone_id,
-    const struct TruckState& truck,
-    const PDPData& data,
-    const vector<double>& Drone_Available_Time
-) {
-    if (customers.empty()) return {numeric_limits<double>::max(), false};
-    
-    // CRITICAL: TAT CA packages phai READY TAI DEPOT truoc khi drone xuat phat
-    // Ready time cua moi customer la thoi diem package cua ho SAN SANG TAI DEPOT
-    // Drone phai DOI package cuoi cung ready, roi moi load va xuat phat
-    double max_ready_time = 0.0;
-    for (int cust : customers) {
-        max_ready_time = max(max_ready_time, (double)data.readyTimes[cust]);
+template <typename TruckCell, typename DroneCell>
+static inline double getDroneDistance(const TravelTimes<TruckCell, DroneCell>& tt, int nodeA_id, int nodeB_id) {
+    return tt.drone.at(nodeA_id, nodeB_id);
+}
+
+// Call body(tt) with the TravelTimes matching the instance's matrix widths
+template <typename Body>
+static inline void withTravelTimes(const PDPData& data, Body&& body) {
+    const TravelTimeMatrix& truck = data.truckDistMatrix;
+    const TravelTimeMatrix& drone = data.droneDistMatrix;
+    if (truck.isNarrow()) {
+        if (drone.isNarrow())
+            body(TravelTimes<int16_t, int16_t>{truck.view<int16_t>(), drone.view<int16_t>()});
+        else
+            body(TravelTimes<int16_t, int32_t>{truck.view<int16_t>(), drone.view<int32_t>()});
+    } else {
+        if (drone.isNarrow())
+            body(TravelTimes<int32_t, int16_t>{truck.view<int32_t>(), drone.view<int16_t>()});
+        else
+            body(TravelTimes<int32_t, int32_t>{truck.view<int32_t>(), drone.view<int32_t>()});
     }
-    
-    // Drone chi xuat phat khi:
-    // 1. Drone da ranh (available)
-    // 2. TAT CA packages da ready tai depot (max_ready_time)
-    double T_Drone_Ready = max(Drone_Available_Time[drone_id], max_ready_time);
-    
-    // Load packages tai depot
-    double drone_depart_time = T_Drone_Ready + data.depotDroneLoadTime;
-    
-    // Chon diem resupply = customer DAU TIEN trong list
-    // (truck se di den day de nhan packages, roi di giao cho tat ca customers)
-    int resupply_point = customers[0];
-    
-    // VALIDATION: Kiem tra resupply point co hop le khong
-    // Ready time tai resupply point phai <= thoi diem drone den
-    // (vi packages da ready tai depot roi, nen ready time tai resupply point khong anh huong)
-    // NHUNG ta van can dam bao truck co the den duoc
-    
-    // PHASE 1: Drone bay THANG tu depot den resupply point
-    double t_fly_to_resupply = getDroneDistance(data, data.depotIndex, resupply_point) / data.droneSpeed * 60.0;
-    double drone_arrive_time = drone_depart_time + t_fly_to_resupply;
-    
-    // PHASE 2: Truck di den resupply point
-    double truck_travel_time = getTruckDistance(data, truck.current_position, resupply_point) / data.truckSpeed * 60.0;
-    double truck_arrive_time = truck.available_time + truck_travel_time;
-    
-    // Thoi gian bat dau resupply = max(drone arrive, truck arrive)
-    // KHONG can kiem tra ready time tai resupply point
-    // Vi ready time chi la thoi diem package XUAT HIEN TAI DEPOT
-    // Sau khi package ready, co the giao cho khach BAT CU LUC NAO
-    double T_Start_Resupply = max(drone_arrive_time, truck_arrive_time);
-    
-    // Thoi gian cho cua drone (neu truck chua den)
-    double wait_time = T_Start_Resupply - drone_arrive_time;
-    
-    // VALIDATION: Neu drone phai doi qua lau -> khong hieu qua
-    // (co the bo qua neu muon linh hoat hon)
-    // if (wait_time > 30.0) return {numeric_limits<double>::max(), false};
-    
-    // Resupply: Drone giao TAT CA packages cho truck
-    double resupply_end = T_Start_Resupply + data.resupplyTime;
-    
-    // PHASE 3: Drone quay ve depot
-    double t_return = getDroneDistance(data, resupply_point, data.depotIndex) / data.droneSpeed * 60.0;
-    double drone_return_time = resupply_end + t_return;
-    
-    // Tinh tong thoi gian bay
-    double total_flight_time = t_fly_to_resupply + wait_time + t_return;
-    
-    // Kiem tra endurance
-    bool feasible = (total_flight_time <= data.droneEndurance);
-    
-    // PHASE 4: Truck di giao hang cho TAT CA customers
-    // Sau khi nhan hang tu drone, truck phai di giao cho tung customer
-    double truck_time = resupply_end;
-    int truck_pos = resupply_point;
-    
-    for (int cust : customers) {
-        // Truck di den customer
-        double travel_time = getTruckDistance(data, truck_pos, cust) / data.truckSpeed * 60.0;
-        double arrival_time = truck_time + travel_time;
-        
-        // Giao hang (service time)
-        truck_time = arrival_time + data.truckServiceTime;
-        truck_pos = cust;
+}
+
+// ============ DECODER WORKSPACE ============
+
+void DecoderWorkspace::prepare(const PDPData& data, int seqLen) {
+    int maxPair = 0;
+    for (int p : data.pairIds) maxPair = max(maxPair, p);
+
+    int cap = max(1, data.getDroneCapacity());
+    bool grow = data.numNodes > numNodes || data.numTrucks != numTrucks ||
+                data.numDrones != numDrones || seqLen > seqCap ||
+                cap != tripCap || maxPair + 1 > pairSlots;
+    if (!grow) return;
+
+    numNodes = max(numNodes, data.numNodes);
+    numTrucks = data.numTrucks;
+    numDrones = data.numDrones;
+    seqCap = max(seqCap, seqLen);
+    tripCap = cap;
+    pairSlots = max(pairSlots, maxPair + 1);
+    routeCap = 2 * seqCap + 2;
+
+    truckTime.assign(numTrucks, 0.0);
+    truckPos.assign(numTrucks, 0);
+    truckLoad.assign(numTrucks, 0.0);
+    cargoEpoch.assign(numTrucks, 0);
+    routeNode.assign((size_t)numTrucks * routeCap, 0);
+    routeArr.assign((size_t)numTrucks * routeCap, 0.0);
+    routeDep.assign((size_t)numTrucks * routeCap, 0.0);
+    routeLen.assign(numTrucks, 0);
+
+    pairStamp.assign((size_t)numTrucks * pairSlots, 0);
+    cargoStamp.assign((size_t)numTrucks * numNodes, 0);
+    processedStamp.assign(numNodes, 0);
+    stamp = 0;
+
+    tripTruck.assign(seqCap, 0);
+    tripDrone.assign(seqCap, 0);
+    tripSize.assign(seqCap, 0);
+    tripCust.assign((size_t)seqCap * tripCap, 0);
+    tripFirstPos.assign(seqCap, 0);
+    tripLastPos.assign(seqCap, 0);
+    activeTrip.assign((size_t)numTrucks * max(1, numDrones), -1);
+    custTrip.assign(numNodes, -1);
+    firstCustTrip.assign(numNodes, -1);
+
+    droneAvail.assign(numDrones, 0.0);
+    droneDone.assign(numDrones, 0.0);
+    events.resize(seqCap);
+}
+
+void DecoderWorkspace::reserveStamps(unsigned count) {
+    if (stamp > numeric_limits<unsigned>::max() - count) {
+        fill(pairStamp.begin(), pairStamp.end(), 0u);
+        fill(cargoStamp.begin(), cargoStamp.end(), 0u);
+        fill(processedStamp.begin(), processedStamp.end(), 0u);
+        stamp = 0;
     }
-    
-    // Completion time = truck finish delivery
-    // C_max is defined as: max(time last vehicle returns to depot, time last customer is delivered)
-    // Drone return time does not determine C_max; only truck delivery times matter here.
-    double completion_time = truck_time;
-    
-    return {completion_time, feasible};
 }
 
 // =========================================================
@@ -166,352 +125,574 @@ static pair<double, bool> evaluateDroneTrip(
 
 // AssignmentEncoding struct is defined in pdp_fitness.h
 
-struct DroneTripGroup {
-    int truck_id;
-    int drone_id;  // 0-based
-    vector<int> customer_ids;
-};
-
-// Build drone trips from encoding
-static vector<DroneTripGroup> buildDroneTrips(
+// Build drone trips from encoding into ws.trip* arrays
+static void buildDroneTrips(
     const vector<int>& seq,
-    const AssignmentEncoding& enc,
-    const PDPData& data
+    const vector<int>& truck_assign,
+    const vector<int>& drone_assign,
+    const vector<int>& break_bit,
+    const PDPData& data,
+    DecoderWorkspace& ws
 ) {
-    vector<DroneTripGroup> trips;
-    map<pair<int,int>, int> active_trip;  // (truck_id, drone_id) -> trip index
+    ws.numTrips = 0;
+    fill(ws.activeTrip.begin(), ws.activeTrip.end(), -1);  // (truck_id, drone_id) -> trip index
 
     for (int i = 0; i < (int)seq.size(); i++) {
         int c = seq[i];
-        if (!data.isCustomer(c)) continue;
-        if (data.nodeTypes[c] != "D" || data.readyTimes[c] <= 0) continue;
-        if (enc.drone_assign[i] == 0) continue;
+        if (!data.isCustomer(c) || !data.isDroneEligible(c)) continue;
+        if (drone_assign[i] == 0) continue;
 
-        int truck_id = enc.truck_assign[i];
-        int drone_id = enc.drone_assign[i] - 1;
-        auto key = make_pair(truck_id, drone_id);
+        int truck_id = truck_assign[i];
+        int drone_id = drone_assign[i] - 1;
+        int key = truck_id * ws.numDrones + drone_id;
 
-        bool start_new = (enc.break_bit[i] == 1) || !active_trip.count(key);
+        bool start_new = (break_bit[i] == 1) || ws.activeTrip[key] < 0;
 
         if (!start_new) {
-            int tidx = active_trip[key];
-            if ((int)trips[tidx].customer_ids.size() >= data.getDroneCapacity()) {
+            int tidx = ws.activeTrip[key];
+            if (ws.tripSize[tidx] >= ws.tripCap) {
                 start_new = true;  // capacity exceeded
             }
         }
 
         if (start_new) {
-            DroneTripGroup trip;
-            trip.truck_id = truck_id;
-            trip.drone_id = drone_id;
-            trip.customer_ids.push_back(c);
-            trips.push_back(trip);
-            active_trip[key] = (int)trips.size() - 1;
+            int tidx = ws.numTrips++;
+            ws.tripTruck[tidx] = truck_id;
+            ws.tripDrone[tidx] = drone_id;
+            ws.tripSize[tidx] = 1;
+            ws.tripCust[(size_t)tidx * ws.tripCap] = c;
+            ws.tripFirstPos[tidx] = i;
+            ws.tripLastPos[tidx] = i;
+            ws.activeTrip[key] = tidx;
         } else {
-            trips[active_trip[key]].customer_ids.push_back(c);
+            int tidx = ws.activeTrip[key];
+            ws.tripCust[(size_t)tidx * ws.tripCap + ws.tripSize[tidx]++] = c;
+            ws.tripLastPos[tidx] = i;
         }
     }
-    return trips;
+
+    // Map customers to trips (later trips win, as with the former std::map assignment)
+    for (int t = 0; t < ws.numTrips; t++) {
+        const int* custs = &ws.tripCust[(size_t)t * ws.tripCap];
+        for (int k = 0; k < ws.tripSize[t]; k++)
+            ws.custTrip[custs[k]] = t;
+        ws.firstCustTrip[custs[0]] = t;
+    }
+}
+
+// Append a visit to truck t's recorded route
+static inline void pushRouteStop(DecoderWorkspace& ws, int t, int node, double arr, double dep) {
+    size_t k = (size_t)t * ws.routeCap + ws.routeLen[t]++;
+    ws.routeNode[k] = node;
+    ws.routeArr[k] = arr;
+    ws.routeDep[k] = dep;
+}
+
+static inline double& routeBackDep(DecoderWorkspace& ws, int t) {
+    return ws.routeDep[(size_t)t * ws.routeCap + ws.routeLen[t] - 1];
 }
 
-// Decode solution from explicit encoding (truck_assign + drone_assign + break_bit)
-static PDPSolution decodeFromEncoding(
+// ============ PREFIX CHECKPOINTS ============
+
+// Size the snapshot buffers and remember the base encoding
+static void beginCheckpoints(
     const vector<int>& seq,
-    const AssignmentEncoding& enc,
-    const PDPData& data
+    const vector<int>& truck_assign,
+    const vector<int>& drone_assign,
+    const vector<int>& break_bit,
+    const DecoderWorkspace& ws,
+    DecoderCheckpoints& cp
 ) {
-    PDPSolution sol;
-    sol.totalCost = 0.0;
-    sol.totalPenalty = 0.0;
-    sol.isFeasible = true;
-    sol.sequence = seq;
-    sol.original_sequence = seq;
-    sol.truck_assign = enc.truck_assign;
-    sol.drone_assign = enc.drone_assign;
-    sol.break_bit = enc.break_bit;
+    cp.interval = max(1, cp.interval);
+    cp.seq = seq;
+    cp.truck_assign = truck_assign;
+    cp.drone_assign = drone_assign;
+    cp.break_bit = break_bit;
+    cp.numNodes = ws.numNodes;
+    cp.numTrucks = ws.numTrucks;
+    cp.numDrones = ws.numDrones;
+    cp.pairSlots = ws.pairSlots;
+    cp.tripCap = ws.tripCap;
+    cp.numSaved = 0;
+
+    size_t slots = seq.empty() ? 0 : (seq.size() - 1) / cp.interval;
+    size_t T = ws.numTrucks, D = ws.numDrones;
+    cp.scalars.resize(slots * 3);
+    cp.truckTime.resize(slots * T);
+    cp.truckPos.resize(slots * T);
+    cp.truckLoad.resize(slots * T);
+    cp.cargoEpoch.resize(slots * T);
+    cp.droneAvail.resize(slots * D);
+    cp.droneDone.resize(slots * D);
+    cp.cargoStamp.resize(slots * ws.cargoStamp.size());
+    cp.pairStamp.resize(slots * ws.pairStamp.size());
+    cp.processedStamp.resize(slots * ws.processedStamp.size());
+}
 
-    if (seq.empty()) {
-        sol.totalPenalty = 1e9;
-        sol.isFeasible = false;
-        return sol;
+// Snapshot the simulation state before the next position (slot = numSaved)
+static void saveCheckpoint(const DecoderWorkspace& ws, double C_max, DecoderCheckpoints& cp) {
+    size_t s = cp.numSaved++;
+    size_t T = ws.numTrucks, D = ws.numDrones;
+    cp.scalars[s * 3] = C_max;
+    cp.scalars[s * 3 + 1] = ws.penalty;
+    cp.scalars[s * 3 + 2] = ws.feasible ? 1.0 : 0.0;
+    copy(ws.truckTime.begin(), ws.truckTime.begin() + T, cp.truckTime.begin() + s * T);
+    copy(ws.truckPos.begin(), ws.truckPos.begin() + T, cp.truckPos.begin() + s * T);
+    copy(ws.truckLoad.begin(), ws.truckLoad.begin() + T, cp.truckLoad.begin() + s * T);
+    copy(ws.cargoEpoch.begin(), ws.cargoEpoch.begin() + T, cp.cargoEpoch.begin() + s * T);
+    copy(ws.droneAvail.begin(), ws.droneAvail.begin() + D, cp.droneAvail.begin() + s * D);
+    copy(ws.droneDone.begin(), ws.droneDone.begin() + D, cp.droneDone.begin() + s * D);
+    copy(ws.cargoStamp.begin(), ws.cargoStamp.end(), cp.cargoStamp.begin() + s * ws.cargoStamp.size());
+    copy(ws.pairStamp.begin(), ws.pairStamp.end(), cp.pairStamp.begin() + s * ws.pairStamp.size());
+    copy(ws.processedStamp.begin(), ws.processedStamp.end(),
+         cp.processedStamp.begin() + s * ws.processedStamp.size());
+}
+
+// Restore the latest checkpoint that the candidate (already trip-built in ws) shares
+// with the base encoding. Returns the position to resume from, or 0 for a full run.
+static int restoreCheckpoint(
+    const vector<int>& seq,
+    const vector<int>& truck_assign,
+    const vector<int>& drone_assign,
+    const vector<int>& break_bit,
+    DecoderWorkspace& ws,
+    const DecoderCheckpoints& cp,
+    double& C_max
+) {
+    int n = (int)seq.size();
+    if (cp.numSaved == 0 || (int)cp.seq.size() != n) return 0;
+    if (cp.numNodes != ws.numNodes || cp.numTrucks != ws.numTrucks || cp.numDrones != ws.numDrones ||
+        cp.pairSlots != ws.pairSlots || cp.tripCap != ws.tripCap) return 0;
+
+    // First changed gene
+    int p = 0;
+    while (p < n && seq[p] == cp.seq[p] && truck_assign[p] == cp.truck_assign[p] &&
+           drone_assign[p] == cp.drone_assign[p] && break_bit[p] == cp.break_bit[p])
+        p++;
+
+    // A drone trip opened before p is simulated at its first customer, so if its
+    // member list changed the run must restart there. Trips opened before p are
+    // numbered identically in both encodings and can only differ past p.
+    int r = p;
+    int baseTrips = (int)cp.tripSize.size();
+    for (int k = 0; k < ws.numTrips && ws.tripFirstPos[k] < p; k++) {
+        if (ws.tripLastPos[k] < p && (k >= baseTrips || cp.tripLastPos[k] < p)) continue;
+        bool same = k < baseTrips && ws.tripSize[k] == cp.tripSize[k] &&
+                    equal(ws.tripCust.begin() + (size_t)k * ws.tripCap,
+                          ws.tripCust.begin() + (size_t)k * ws.tripCap + ws.tripSize[k],
+                          cp.tripCust.begin() + (size_t)k * ws.tripCap);
+        if (!same) r = min(r, ws.tripFirstPos[k]);
     }
 
-    // Pre-build drone trips
-    auto drone_trips = buildDroneTrips(seq, enc, data);
-
-    // Map customers to trips
-    map<int, int> customer_to_trip;
-    set<int> trip_first_custs;
-    map<int, int> first_cust_to_trip;
-
-    for (int t = 0; t < (int)drone_trips.size(); t++) {
-        for (int c : drone_trips[t].customer_ids)
-            customer_to_trip[c] = t;
-        if (!drone_trips[t].customer_ids.empty()) {
-            int first = drone_trips[t].customer_ids[0];
-            trip_first_custs.insert(first);
-            first_cust_to_trip[first] = t;
+    // Slot s holds the state before position (s + 1) * interval
+    int s = min(r / cp.interval, cp.numSaved) - 1;
+    if (s < 0) return 0;
+
+    // Restored arrays carry the base run's stamps: new ones must be larger.
+    if (cp.stampHigh > numeric_limits<unsigned>::max() - (unsigned)(n + 1)) return 0;
+    if (ws.stamp < cp.stampHigh) ws.stamp = cp.stampHigh;
+
+    size_t T = ws.numTrucks, D = ws.numDrones;
+    C_max = cp.scalars[s * 3];
+    ws.penalty = cp.scalars[s * 3 + 1];
+    ws.feasible = cp.scalars[s * 3 + 2] != 0.0;
+    ws.decodeStamp = cp.decodeStamp;
+    copy(cp.truckTime.begin() + s * T, cp.truckTime.begin() + (s + 1) * T, ws.truckTime.begin());
+    copy(cp.truckPos.begin() + s * T, cp.truckPos.begin() + (s + 1) * T, ws.truckPos.begin());
+    copy(cp.truckLoad.begin() + s * T, cp.truckLoad.begin() + (s + 1) * T, ws.truckLoad.begin());
+    copy(cp.cargoEpoch.begin() + s * T, cp.cargoEpoch.begin() + (s + 1) * T, ws.cargoEpoch.begin());
+    copy(cp.droneAvail.begin() + s * D, cp.droneAvail.begin() + (s + 1) * D, ws.droneAvail.begin());
+    copy(cp.droneDone.begin() + s * D, cp.droneDone.begin() + (s + 1) * D, ws.droneDone.begin());
+    size_t nc = ws.cargoStamp.size(), np = ws.pairStamp.size(), nq = ws.processedStamp.size();
+    copy(cp.cargoStamp.begin() + s * nc, cp.cargoStamp.begin() + (s + 1) * nc, ws.cargoStamp.begin());
+    copy(cp.pairStamp.begin() + s * np, cp.pairStamp.begin() + (s + 1) * np, ws.pairStamp.begin());
+    copy(cp.processedStamp.begin() + s * nq, cp.processedStamp.begin() + (s + 1) * nq,
+         ws.processedStamp.begin());
+    return (s + 1) * cp.interval;
+}
+
+// Truck that serves customer v_id at sequence position seq_idx: a DL node follows the
+// truck holding its pickup (-1 if none has picked it up yet), any other node its encoded truck.
+static inline int servingTruck(
+    const vector<int>& truck_assign,
+    const PDPData& data,
+    const DecoderWorkspace& ws,
+    int seq_idx,
+    int v_id
+) {
+    int v_pairId = data.pairIds[v_id];
+    if (data.nodeKind[v_id] == NODE_DL && v_pairId > 0) {
+        for (int t = 0; t < data.numTrucks; t++) {
+            if (ws.pairStamp[(size_t)t * ws.pairSlots + v_pairId] == ws.decodeStamp)
+                return t;
         }
+        return -1;
     }
+    int truck_id = truck_assign[seq_idx];
+    if (truck_id < 0 || truck_id >= data.numTrucks) truck_id = 0;
+    return truck_id;
+}
 
-    // Init trucks
-    double C_max = 0.0;
-    vector<TruckState> trucks(data.numTrucks);
-    for (int i = 0; i < data.numTrucks; i++) {
-        trucks[i].available_time = 0.0;
-        trucks[i].current_position = data.depotIndex;
-        trucks[i].current_load = 0.0;
-        trucks[i].route.push_back(data.depotIndex);
-        trucks[i].arrival_times.push_back(0.0);
-        trucks[i].departure_times.push_back(0.0);
+// Serve customer v_id (sequence position seq_idx) with truck truck_id, including the drone
+// trip it starts. Makespan and penalty contributions go to C_max / totalPenalty / isFeasible.
+template <typename Times>
+static inline void serveCustomer(
+    const vector<int>& drone_assign,
+    const PDPData& data,
+    const Times& tt,
+    DecoderWorkspace& ws,
+    int seq_idx,
+    int v_id,
+    int truck_id,
+    bool record,
+    double& C_max,
+    double& totalPenalty,
+    bool& isFeasible
+) {
+    const uint8_t v_kind = data.nodeKind[v_id];
+    int v_ready = data.readyTimes[v_id];
+    int v_demand = data.demands[v_id];
+    int v_pairId = data.pairIds[v_id];
+    double e_v = (double)v_ready;
+
+    // ===== DL: FORCED to pickup truck =====
+    if (v_kind == NODE_DL && v_pairId > 0) {
+        int t = truck_id;
+        double T_Arr = ws.truckTime[t] +
+            getTruckDistance(tt, ws.truckPos[t], v_id) / data.truckSpeed * 60.0;
+        ws.truckTime[t] = T_Arr + data.truckServiceTime;
+        ws.truckPos[t] = v_id;
+        if (record) pushRouteStop(ws, t, v_id, T_Arr, ws.truckTime[t]);
+        ws.truckLoad[t] += v_demand;
+
+        if (ws.truckLoad[t] < -0.01) { totalPenalty += 1000; isFeasible = false; }
+        if (ws.truckLoad[t] > data.truckCapacity) { totalPenalty += 1000; isFeasible = false; }
+
+        ws.pairStamp[(size_t)t * ws.pairSlots + v_pairId] = 0;
+        C_max = max(C_max, ws.truckTime[t]);
+        return;
     }
 
-    vector<double> Drone_Available_Time(data.numDrones, 0.0);
-    sol.drone_completion_times.resize(data.numDrones, 0.0);
-
-    set<int> processed_customers;
-
-    for (int seq_idx = 0; seq_idx < (int)seq.size(); seq_idx++) {
-        int v_id = seq[seq_idx];
-        if (!data.isCustomer(v_id)) continue;
-        if (processed_customers.count(v_id)) continue;
-
-        string v_type = data.nodeTypes[v_id];
-        int v_ready = data.readyTimes[v_id];
-        int v_demand = data.demands[v_id];
-        int v_pairId = data.pairIds[v_id];
-        double e_v = (double)v_ready;
+    double& truck_time = ws.truckTime[truck_id];
+    int& truck_pos = ws.truckPos[truck_id];
+    double& truck_load = ws.truckLoad[truck_id];
+    unsigned* cargo = &ws.cargoStamp[(size_t)truck_id * ws.numNodes];
+    // ===== Type D =====
+    if (v_kind == NODE_D) {
+        // Cargo already on truck (from previous depot return)
+        if (cargo[v_id] == ws.cargoEpoch[truck_id]) {
+            double T_Arr = truck_time +
+                getTruckDistance(tt, truck_pos, v_id) / data.truckSpeed * 60.0;
+            truck_time = T_Arr + data.truckServiceTime;
+            truck_pos = v_id;
+            if (record) pushRouteStop(ws, truck_id, v_id, T_Arr, truck_time);
+            truck_load -= v_demand;
+            cargo[v_id] = 0;
+            C_max = max(C_max, truck_time);
+            return;
+        }
 
-        // ===== DL: FORCED to pickup truck =====
-        if (v_type == "DL" && v_pairId > 0) {
-            int pickup_truck_id = -1;
-            for (int t = 0; t < data.numTrucks; t++) {
-                if (trucks[t].picked_up_pairs.count(v_pairId)) {
-                    pickup_truck_id = t;
-                    break;
+        int drone_val = drone_assign[seq_idx];
+
+        if (drone_val > 0 && ws.firstCustTrip[v_id] >= 0) {
+            // DRONE RESUPPLY: This is the first customer of a trip
+            int tidx = ws.firstCustTrip[v_id];
+            const int* trip_custs = &ws.tripCust[(size_t)tidx * ws.tripCap];
+            int trip_size = ws.tripSize[tidx];
+            int drone_id = ws.tripDrone[tidx];
+
+            // Drone waits for the last package to be ready at the depot, loads, then flies
+            // straight to the rendezvous (first customer of the trip) and back.
+            double max_ready = 0.0;
+            for (int k = 0; k < trip_size; k++)
+                max_ready = max(max_ready, (double)data.readyTimes[trip_custs[k]]);
+
+            DecoderWorkspace::Event& event = ws.events[ws.numEvents];
+            event.trip = tidx;
+            event.drone_id = drone_id;
+            event.truck_id = truck_id;
+
+            double T_Drone_Ready = max(ws.droneAvail[drone_id], max_ready);
+            event.drone_depart_time = T_Drone_Ready + data.depotDroneLoadTime;
+
+            int resupply_point = trip_custs[0];
+            event.resupply_point = resupply_point;
+
+            double t_fly = getDroneDistance(tt, data.depotIndex, resupply_point)
+                           / data.droneSpeed * 60.0;
+            event.drone_arrive_time = event.drone_depart_time + t_fly;
+
+            double truck_travel = getTruckDistance(tt, truck_pos, resupply_point)
+                                  / data.truckSpeed * 60.0;
+            event.truck_arrive_time = truck_time + truck_travel;
+
+            double resupply_start = max(event.drone_arrive_time, event.truck_arrive_time);
+            double wait = resupply_start - event.drone_arrive_time;
+            event.resupply_start_time = resupply_start;
+            event.resupply_end_time = resupply_start + data.resupplyTime;
+
+            double t_return = getDroneDistance(tt, resupply_point, data.depotIndex)
+                              / data.droneSpeed * 60.0;
+            event.drone_return_time = event.resupply_end_time + t_return;
+            event.total_flight_time = t_fly + wait + t_return;
+
+            if (event.total_flight_time <= data.droneEndurance) {
+                // === FEASIBLE: schedule drone resupply ===
+                // Truck route: go to resupply point, deliver first customer
+                double departure_from_resupply = event.resupply_end_time + data.truckServiceTime;
+                if (record)
+                    pushRouteStop(ws, truck_id, resupply_point, event.truck_arrive_time, departure_from_resupply);
+                truck_pos = resupply_point;
+                truck_time = departure_from_resupply;
+
+                // Deliver remaining customers in trip
+                for (int k = 0; k < trip_size; k++) {
+                    int cust_id = trip_custs[k];
+                    if (cust_id == resupply_point) continue;
+                    double travel = getTruckDistance(tt, truck_pos, cust_id)
+                                    / data.truckSpeed * 60.0;
+                    double arrival = truck_time + travel;
+                    double departure = arrival + data.truckServiceTime;
+                    if (record) pushRouteStop(ws, truck_id, cust_id, arrival, departure);
+                    truck_pos = cust_id;
+                    truck_time = departure;
                 }
-            }
-            if (pickup_truck_id == -1) {
-                sol.totalPenalty += 10000;
-                sol.isFeasible = false;
-                continue;
-            }
 
-            TruckState& truck = trucks[pickup_truck_id];
-            double T_Arr = truck.available_time +
-                getTruckDistance(data, truck.current_position, v_id) / data.truckSpeed * 60.0;
-            truck.available_time = T_Arr + data.truckServiceTime;
-            truck.current_position = v_id;
-            truck.route.push_back(v_id);
-            truck.arrival_times.push_back(T_Arr);
-            truck.departure_times.push_back(truck.available_time);
-            truck.current_load += v_demand;
+                event.truck_delivery_end = truck_time;
+                if (record) ws.numEvents++;
 
-            if (truck.current_load < -0.01) { sol.totalPenalty += 1000; sol.isFeasible = false; }
-            if (truck.current_load > data.truckCapacity) { sol.totalPenalty += 1000; sol.isFeasible = false; }
+                ws.droneAvail[drone_id] = event.drone_return_time;
+                ws.droneDone[drone_id] = max(ws.droneDone[drone_id], event.drone_return_time);
+                C_max = max(C_max, event.drone_return_time);
+                C_max = max(C_max, truck_time);
 
-            truck.picked_up_pairs.erase(v_pairId);
-            C_max = max(C_max, truck.available_time);
-            continue;
+                for (int k = 0; k < trip_size; k++)
+                    ws.processedStamp[trip_custs[k]] = ws.decodeStamp;
+                return;
+            } else {
+                // Infeasible drone trip -> penalty, fallback to depot return
+                totalPenalty += 500;
+            }
+        } else if (drone_val > 0 && ws.custTrip[v_id] >= 0) {
+            // Not first customer of trip -> already processed or will be
+            return;
         }
 
-        // ===== Get truck from encoding =====
-        int truck_id = enc.truck_assign[seq_idx];
-        if (truck_id < 0 || truck_id >= data.numTrucks) truck_id = 0;
-        TruckState& truck = trucks[truck_id];
-
-        // ===== Type D =====
-        if (v_type == "D" && v_ready > 0) {
-            // Cargo already on truck (from previous depot return)
-            if (truck.cargo_on_truck.count(v_id) > 0) {
-                double T_Arr = truck.available_time +
-                    getTruckDistance(data, truck.current_position, v_id) / data.truckSpeed * 60.0;
-                truck.available_time = T_Arr + data.truckServiceTime;
-                truck.current_position = v_id;
-                truck.route.push_back(v_id);
-                truck.arrival_times.push_back(T_Arr);
-                truck.departure_times.push_back(truck.available_time);
-                truck.current_load -= v_demand;
-                truck.cargo_on_truck.erase(v_id);
-                C_max = max(C_max, truck.available_time);
-                continue;
-            }
+        // DEPOT RETURN (drone_val=0 or drone infeasible)
+        if (truck_pos != data.depotIndex) {
+            double t_to_depot = getTruckDistance(tt, truck_pos, data.depotIndex)
+                                / data.truckSpeed * 60.0;
+            double T_Arr_Depot = truck_time + t_to_depot;
+            if (record)
+                pushRouteStop(ws, truck_id, data.depotIndex, T_Arr_Depot, T_Arr_Depot + data.depotReceiveTime);
+            truck_time = T_Arr_Depot + data.depotReceiveTime;
+            truck_pos = data.depotIndex;
+            truck_load = 0.0;
+            ws.cargoEpoch[truck_id] = ws.nextStamp();  // cargo_on_truck.clear()
+        }
 
-            int drone_val = enc.drone_assign[seq_idx];
+        double T_Depart = max(truck_time, (double)v_ready);
+        // (route.back() is the depot exactly when the truck stands there)
+        if (record && truck_pos == data.depotIndex)
+            routeBackDep(ws, truck_id) = T_Depart;
+        truck_time = T_Depart;
+
+        truck_load += v_demand;
+        cargo[v_id] = ws.cargoEpoch[truck_id];
+
+        double t_to_cust = getTruckDistance(tt, data.depotIndex, v_id)
+                           / data.truckSpeed * 60.0;
+        double T_Arr = truck_time + t_to_cust;
+        double T_Start = max(T_Arr, e_v);
+        truck_time = T_Start + data.truckServiceTime;
+        truck_pos = v_id;
+        if (record) pushRouteStop(ws, truck_id, v_id, T_Arr, truck_time);
+        truck_load -= v_demand;
+        cargo[v_id] = 0;
+
+        if (truck_load > data.truckCapacity) { totalPenalty += 1000; isFeasible = false; }
+        if (truck_load < -0.01) { totalPenalty += 1000; isFeasible = false; }
+    }
+    // ===== Type P =====
+    else if (v_kind == NODE_P) {
+        if (truck_pos == data.depotIndex && e_v > truck_time) {
+            truck_time = e_v;
+            if (record) routeBackDep(ws, truck_id) = e_v;
+        }
 
-            if (drone_val > 0 && trip_first_custs.count(v_id)) {
-                // DRONE RESUPPLY: This is the first customer of a trip
-                int tidx = first_cust_to_trip[v_id];
-                auto& trip = drone_trips[tidx];
-                int drone_id = trip.drone_id;
+        double T_Arr = truck_time +
+            getTruckDistance(tt, truck_pos, v_id) / data.truckSpeed * 60.0;
+        double T_Start = max(T_Arr, e_v);
+        truck_time = T_Start + data.truckServiceTime;
+        truck_pos = v_id;
+        if (record) pushRouteStop(ws, truck_id, v_id, T_Arr, truck_time);
 
-                auto result = evaluateDroneTrip(
-                    trip.customer_ids, drone_id, truck, data, Drone_Available_Time
-                );
+        truck_load += v_demand;
+        cargo[v_id] = ws.cargoEpoch[truck_id];
+        if (v_pairId > 0) ws.pairStamp[(size_t)truck_id * ws.pairSlots + v_pairId] = ws.decodeStamp;
 
-                if (result.second) {
-                    // === FEASIBLE: schedule drone resupply ===
-                    ResupplyEvent event;
-                    event.customer_ids = trip.customer_ids;
-                    event.drone_id = drone_id;
-                    event.truck_id = truck_id;
+        if (truck_load > data.truckCapacity) { totalPenalty += 1000; isFeasible = false; }
+        if (truck_load < 0) { totalPenalty += 1000; isFeasible = false; }
+    }
 
-                    double max_ready = 0.0;
-                    for (int cust : trip.customer_ids)
-                        max_ready = max(max_ready, (double)data.readyTimes[cust]);
+    C_max = max(C_max, truck_time);
+}
 
-                    double T_Drone_Ready = max(Drone_Available_Time[drone_id], max_ready);
-                    event.drone_depart_time = T_Drone_Ready + data.depotDroneLoadTime;
+// Lower bound on the final depot return of truck t: it only moves forward in time, and
+// a truck away from the depot still has at least the shortest leg into it ahead
+static inline double truckFinishBound(const PDPData& data, const DecoderWorkspace& ws, int t) {
+    if (ws.truckPos[t] == data.depotIndex) return ws.truckTime[t];
+    return ws.truckTime[t] + data.truckNearestTime[data.depotIndex];
+}
 
-                    int resupply_point = trip.customer_ids[0];
-                    event.resupply_point = resupply_point;
+// True once a lower bound has passed the abort threshold (with slack for rounding)
+static inline bool passesBound(double lowerBound, double abortAbove) {
+    return lowerBound > abortAbove + 1e-9 * max(1.0, fabs(abortAbove));
+}
 
-                    double t_fly = getDroneDistance(data, data.depotIndex, resupply_point)
-                                   / data.droneSpeed * 60.0;
-                    event.drone_arrive_time = event.drone_depart_time + t_fly;
+// Simulate an explicit encoding (truck_assign + drone_assign + break_bit) into ws.
+// Fills ws.cmax / ws.penalty / ws.feasible; routes and events only when record is set.
+//
+// Without recording, the propagate-delay pass is skipped: a resupply point is left at
+// resupply_end + truckServiceTime, so that pass can only move times when the service
+// time is negative (then we record anyway).
+//
+// Cost-only runs can also snapshot their state every cp.interval positions (save) or
+// resume from the snapshots of a previous run (resume); the final depot-return pass
+// always runs on the resumed state.
+//
+// A finite abortAbove makes a cost-only run without save stop as soon as a lower bound
+// on C_max + penaltyWeight * penalty passes it (ws.pruned; ws.cmax / ws.penalty then
+// hold the bound): the makespan and penalty so far and truckFinishBound of each truck,
+// all of which only grow. Checking it costs O(1) per customer.
+template <typename Times>
+static void simulateEncodingWith(
+    const Times& tt,
+    const vector<int>& seq,
+    const vector<int>& truck_assign,
+    const vector<int>& drone_assign,
+    const vector<int>& break_bit,
+    const PDPData& data,
+    DecoderWorkspace& ws,
+    bool record,
+    DecoderCheckpoints* save,
+    const DecoderCheckpoints* resume,
+    double abortAbove,
+    double penaltyWeight
+) {
+    if (data.truckServiceTime < 0) record = true;
+    if (record) save = nullptr, resume = nullptr;
+    if (save) save->numSaved = 0;
+    ws.prepare(data, (int)seq.size());
+    ws.cmax = 0.0;
+    ws.penalty = 0.0;
+    ws.feasible = true;
+    ws.pruned = false;
+    ws.numEvents = 0;
+    ws.numTrips = 0;
 
-                    double truck_travel = getTruckDistance(data, truck.current_position, resupply_point)
-                                          / data.truckSpeed * 60.0;
-                    event.truck_arrive_time = truck.available_time + truck_travel;
+    if (seq.empty()) {
+        ws.penalty = 1e9;
+        ws.feasible = false;
+        for (int i = 0; i < data.numTrucks; i++) ws.routeLen[i] = 0;
+        return;
+    }
 
-                    double resupply_start = max(event.drone_arrive_time, event.truck_arrive_time);
-                    double wait = resupply_start - event.drone_arrive_time;
-                    event.resupply_start_time = resupply_start;
-                    event.resupply_end_time = resupply_start + data.resupplyTime;
-
-                    double t_return = getDroneDistance(data, resupply_point, data.depotIndex)
-                                      / data.droneSpeed * 60.0;
-                    event.drone_return_time = event.resupply_end_time + t_return;
-                    event.total_flight_time = t_fly + wait + t_return;
-
-                    // Truck route: go to resupply point, deliver first customer
-                    double departure_from_resupply = event.resupply_end_time + data.truckServiceTime;
-                    truck.route.push_back(resupply_point);
-                    truck.arrival_times.push_back(event.truck_arrive_time);
-                    truck.departure_times.push_back(departure_from_resupply);
-                    truck.current_position = resupply_point;
-                    truck.available_time = departure_from_resupply;
-
-                    // Deliver remaining customers in trip
-                    for (int cust_id : trip.customer_ids) {
-                        if (cust_id == resupply_point) continue;
-                        double travel = getTruckDistance(data, truck.current_position, cust_id)
-                                        / data.truckSpeed * 60.0;
-                        double arrival = truck.available_time + travel;
-                        double departure = arrival + data.truckServiceTime;
-                        truck.route.push_back(cust_id);
-                        truck.arrival_times.push_back(arrival);
-                        truck.departure_times.push_back(departure);
-                        truck.current_position = cust_id;
-                        truck.available_time = departure;
-                    }
+    // Reset per-node lookups for the customers of this sequence
+    for (int c : seq) {
+        if (c < 0 || c >= data.numNodes) continue;
+        ws.custTrip[c] = -1;
+        ws.firstCustTrip[c] = -1;
+    }
 
-                    event.truck_delivery_end = truck.available_time;
-                    sol.resupply_events.push_back(event);
-
-                    Drone_Available_Time[drone_id] = event.drone_return_time;
-                    sol.drone_completion_times[drone_id] =
-                        max(sol.drone_completion_times[drone_id], event.drone_return_time);
-                    C_max = max(C_max, event.drone_return_time);
-                    C_max = max(C_max, truck.available_time);
-
-                    for (int c : trip.customer_ids)
-                        processed_customers.insert(c);
-                    continue;
-                } else {
-                    // Infeasible drone trip -> penalty, fallback to depot return
-                    sol.totalPenalty += 500;
-                }
-            } else if (drone_val > 0 && customer_to_trip.count(v_id)) {
-                // Not first customer of trip -> already processed or will be
-                continue;
-            }
+    // Pre-build drone trips
+    buildDroneTrips(seq, truck_assign, drone_assign, break_bit, data, ws);
 
-            // DEPOT RETURN (drone_val=0 or drone infeasible)
-            if (truck.current_position != data.depotIndex) {
-                double t_to_depot = getTruckDistance(data, truck.current_position, data.depotIndex)
-                                    / data.truckSpeed * 60.0;
-                double T_Arr_Depot = truck.available_time + t_to_depot;
-                truck.route.push_back(data.depotIndex);
-                truck.arrival_times.push_back(T_Arr_Depot);
-                truck.departure_times.push_back(T_Arr_Depot + data.depotReceiveTime);
-                truck.available_time = T_Arr_Depot + data.depotReceiveTime;
-                truck.current_position = data.depotIndex;
-                truck.current_load = 0.0;
-                truck.cargo_on_truck.clear();
-            }
+    // Init trucks (one stamp per decode, per truck, and per possible depot return)
+    ws.reserveStamps((unsigned)(1 + data.numTrucks + seq.size()));
+    double C_max = 0.0;
+    int start_idx = resume ? restoreCheckpoint(seq, truck_assign, drone_assign, break_bit, ws, *resume, C_max) : 0;
+    if (start_idx == 0) {
+        ws.decodeStamp = ws.nextStamp();  // pair + processed sets of this decode
+        for (int i = 0; i < data.numTrucks; i++) {
+            ws.truckTime[i] = 0.0;
+            ws.truckPos[i] = data.depotIndex;
+            ws.truckLoad[i] = 0.0;
+            ws.cargoEpoch[i] = ws.nextStamp();
+            ws.routeLen[i] = 0;
+            if (record) pushRouteStop(ws, i, data.depotIndex, 0.0, 0.0);
+        }
 
-            double T_Depart = max(truck.available_time, (double)v_ready);
-            if (!truck.route.empty() && truck.route.back() == data.depotIndex)
-                truck.departure_times.back() = T_Depart;
-            truck.available_time = T_Depart;
+        fill(ws.droneAvail.begin(), ws.droneAvail.end(), 0.0);
+        fill(ws.droneDone.begin(), ws.droneDone.end(), 0.0);
+    }
+    if (save) beginCheckpoints(seq, truck_assign, drone_assign, break_bit, ws, *save);
+
+    double& totalPenalty = ws.penalty;
+    bool& isFeasible = ws.feasible;
+
+    // Bounded run: a resumed state may already be past the bound
+    bool bounded = !record && !save && abortAbove < numeric_limits<double>::infinity();
+    double timeBound = C_max;
+    if (bounded) {
+        for (int t = 0; t < data.numTrucks; t++)
+            timeBound = max(timeBound, truckFinishBound(data, ws, t));
+        if (passesBound(timeBound + penaltyWeight * totalPenalty, abortAbove)) {
+            ws.pruned = true;
+            ws.cmax = timeBound;
+            ws.feasible = false;
+            return;
+        }
+    }
 
-            truck.current_load += v_demand;
-            truck.cargo_on_truck.insert(v_id);
+    for (int seq_idx = start_idx; seq_idx < (int)seq.size(); seq_idx++) {
+        if (save && seq_idx > 0 && seq_idx % save->interval == 0)
+            saveCheckpoint(ws, C_max, *save);
 
-            double t_to_cust = getTruckDistance(data, data.depotIndex, v_id)
-                               / data.truckSpeed * 60.0;
-            double T_Arr = truck.available_time + t_to_cust;
-            double T_Start = max(T_Arr, e_v);
-            truck.available_time = T_Start + data.truckServiceTime;
-            truck.current_position = v_id;
-            truck.route.push_back(v_id);
-            truck.arrival_times.push_back(T_Arr);
-            truck.departure_times.push_back(truck.available_time);
-            truck.current_load -= v_demand;
-            truck.cargo_on_truck.erase(v_id);
+        int v_id = seq[seq_idx];
+        if (!data.isCustomer(v_id)) continue;
+        if (ws.processedStamp[v_id] == ws.decodeStamp) continue;
 
-            if (truck.current_load > data.truckCapacity) { sol.totalPenalty += 1000; sol.isFeasible = false; }
-            if (truck.current_load < -0.01) { sol.totalPenalty += 1000; sol.isFeasible = false; }
+        int truck_id = servingTruck(truck_assign, data, ws, seq_idx, v_id);
+        if (truck_id < 0) {
+            totalPenalty += 10000;
+            isFeasible = false;
+            continue;
         }
-        // ===== Type P =====
-        else if (v_type == "P") {
-            if (truck.current_position == data.depotIndex &&
-                !truck.route.empty() && truck.route.back() == data.depotIndex &&
-                e_v > truck.available_time) {
-                truck.available_time = e_v;
-                truck.departure_times.back() = e_v;
+        serveCustomer(drone_assign, data, tt, ws, seq_idx, v_id, truck_id, record,
+                      C_max, totalPenalty, isFeasible);
+
+        if (bounded) {
+            timeBound = max(timeBound, max(C_max, truckFinishBound(data, ws, truck_id)));
+            if (passesBound(timeBound + penaltyWeight * totalPenalty, abortAbove)) {
+                ws.pruned = true;
+                ws.cmax = timeBound;
+                ws.feasible = false;
+                return;
             }
-
-            double T_Arr = truck.available_time +
-                getTruckDistance(data, truck.current_position, v_id) / data.truckSpeed * 60.0;
-            double T_Start = max(T_Arr, e_v);
-            truck.available_time = T_Start + data.truckServiceTime;
-            truck.current_position = v_id;
-            truck.route.push_back(v_id);
-            truck.arrival_times.push_back(T_Arr);
-            truck.departure_times.push_back(truck.available_time);
-
-            truck.current_load += v_demand;
-            truck.cargo_on_truck.insert(v_id);
-            if (v_pairId > 0) truck.picked_up_pairs.insert(v_pairId);
-
-            if (truck.current_load > data.truckCapacity) { sol.totalPenalty += 1000; sol.isFeasible = false; }
-            if (truck.current_load < 0) { sol.totalPenalty += 1000; sol.isFeasible = false; }
         }
-
-        C_max = max(C_max, truck.available_time);
     }
 
     // ===== PROPAGATE DELAY =====
-    for (auto& event : sol.resupply_events) {
-        if (event.customer_ids.empty()) continue;
+    for (int e = 0; e < ws.numEvents; e++) {
+        const DecoderWorkspace::Event& event = ws.events[e];
         int tid = event.truck_id;
-        if (tid < 0 || tid >= (int)trucks.size()) continue;
+        if (tid < 0 || tid >= data.numTrucks) continue;
         int rp = event.resupply_point;
-        if (rp <= 0) rp = event.customer_ids[0];
-        auto& tr = trucks[tid];
-        for (size_t k = 0; k < tr.route.size(); k++) {
-            if (tr.route[k] == rp) {
+        if (rp <= 0) rp = ws.tripCust[(size_t)event.trip * ws.tripCap];
+        size_t base = (size_t)tid * ws.routeCap;
+        int len = ws.routeLen[tid];
+        for (int k = 0; k < len; k++) {
+            if (ws.routeNode[base + k] == rp) {
                 double required = event.resupply_end_time;
-                if (required > tr.departure_times[k]) {
-                    double delay = required - tr.departure_times[k];
-                    tr.departure_times[k] = required;
-                    for (size_t m = k + 1; m < tr.route.size(); m++) {
-                        tr.arrival_times[m] += delay;
-                        tr.departure_times[m] += delay;
+                if (required > ws.routeDep[base + k]) {
+                    double delay = required - ws.routeDep[base + k];
+                    ws.routeDep[base + k] = required;
+                    for (int m = k + 1; m < len; m++) {
+                        ws.routeArr[base + m] += delay;
+                        ws.routeDep[base + m] += delay;
                     }
-                    tr.available_time = tr.departure_times.back();
+                    ws.truckTime[tid] = ws.routeDep[base + len - 1];
                 }
                 break;
             }
@@ -519,49 +700,290 @@ static PDPSolution decodeFromEncoding(
     }
 
     // Update C_max
-    for (const auto& event : sol.resupply_events) {
-        C_max = max(C_max, event.drone_return_time);
-        C_max = max(C_max, event.truck_delivery_end);
+    for (int e = 0; e < ws.numEvents; e++) {
+        C_max = max(C_max, ws.events[e].drone_return_time);
+        C_max = max(C_max, ws.events[e].truck_delivery_end);
     }
     for (int i = 0; i < data.numTrucks; i++)
-        C_max = max(C_max, trucks[i].available_time);
+        C_max = max(C_max, ws.truckTime[i]);
     for (int d = 0; d < data.numDrones; d++)
-        C_max = max(C_max, sol.drone_completion_times[d]);
+        C_max = max(C_max, ws.droneDone[d]);
 
     // Return to depot
     for (int i = 0; i < data.numTrucks; i++) {
-        if (trucks[i].current_position != data.depotIndex) {
-            double T_Return = trucks[i].available_time +
-                getTruckDistance(data, trucks[i].current_position, data.depotIndex)
+        if (ws.truckPos[i] != data.depotIndex) {
+            double T_Return = ws.truckTime[i] +
+                getTruckDistance(tt, ws.truckPos[i], data.depotIndex)
                 / data.truckSpeed * 60.0;
-            trucks[i].route.push_back(data.depotIndex);
-            trucks[i].arrival_times.push_back(T_Return);
-            trucks[i].departure_times.push_back(T_Return);
-            trucks[i].available_time = T_Return;
+            if (record) pushRouteStop(ws, i, data.depotIndex, T_Return, T_Return);
+            ws.truckTime[i] = T_Return;
             C_max = max(C_max, T_Return);
         }
+    }
+
+    ws.cmax = C_max;
+    if (ws.penalty > 1.0) ws.feasible = false;
+
+    if (save) {
+        save->tripLastPos.assign(ws.tripLastPos.begin(), ws.tripLastPos.begin() + ws.numTrips);
+        save->tripSize.assign(ws.tripSize.begin(), ws.tripSize.begin() + ws.numTrips);
+        save->tripCust.assign(ws.tripCust.begin(), ws.tripCust.begin() + (size_t)ws.numTrips * ws.tripCap);
+        save->decodeStamp = ws.decodeStamp;
+        save->stampHigh = ws.stamp;
+    }
+}
+
+static void simulateEncoding(
+    const vector<int>& seq,
+    const vector<int>& truck_assign,
+    const vector<int>& drone_assign,
+    const vector<int>& break_bit,
+    const PDPData& data,
+    DecoderWorkspace& ws,
+    bool record,
+    DecoderCheckpoints* save = nullptr,
+    const DecoderCheckpoints* resume = nullptr,
+    double abortAbove = numeric_limits<double>::infinity(),
+    double penaltyWeight = 1.0
+) {
+    withTravelTimes(data, [&](const auto& tt) {
+        simulateEncodingWith(tt, seq, truck_assign, drone_assign, break_bit, data, ws, record,
+                             save, resume, abortAbove, penaltyWeight);
+    });
+}
+
+// Copy the simulated state out of the workspace into a full PDPSolution
+static PDPSolution buildSolution(
+    const vector<int>& seq,
+    const vector<int>& truck_assign,
+    const vector<int>& drone_assign,
+    const vector<int>& break_bit,
+    const PDPData& data,
+    const DecoderWorkspace& ws
+) {
+    PDPSolution sol;
+    sol.sequence = seq;
+    sol.original_sequence = seq;
+    sol.truck_assign = truck_assign;
+    sol.drone_assign = drone_assign;
+    sol.break_bit = break_bit;
+    sol.totalCost = 0.0;
+    sol.totalPenalty = ws.penalty;
+    sol.isFeasible = ws.feasible;
+    if (seq.empty()) return sol;
+
+    sol.totalCost = ws.cmax;
+    sol.drone_completion_times.assign(ws.droneDone.begin(), ws.droneDone.begin() + data.numDrones);
+
+    sol.resupply_events.reserve(ws.numEvents);
+    for (int e = 0; e < ws.numEvents; e++) {
+        const DecoderWorkspace::Event& src = ws.events[e];
+        ResupplyEvent event;
+        const int* custs = &ws.tripCust[(size_t)src.trip * ws.tripCap];
+        event.customer_ids.assign(custs, custs + ws.tripSize[src.trip]);
+        event.resupply_point = src.resupply_point;
+        event.drone_id = src.drone_id;
+        event.truck_id = src.truck_id;
+        event.drone_depart_time = src.drone_depart_time;
+        event.drone_arrive_time = src.drone_arrive_time;
+        event.truck_arrive_time = src.truck_arrive_time;
+        event.resupply_start_time = src.resupply_start_time;
+        event.resupply_end_time = src.resupply_end_time;
+        event.drone_return_time = src.drone_return_time;
+        event.total_flight_time = src.total_flight_time;
+        event.truck_delivery_end = src.truck_delivery_end;
+        sol.resupply_events.push_back(std::move(event));
+    }
+
+    sol.truck_details.reserve(data.numTrucks);
+    for (int i = 0; i < data.numTrucks; i++) {
+        size_t base = (size_t)i * ws.routeCap;
+        int len = ws.routeLen[i];
         TruckRouteInfo info;
         info.truck_id = i;
-        info.route = trucks[i].route;
-        info.arrival_times = trucks[i].arrival_times;
-        info.departure_times = trucks[i].departure_times;
-        info.completion_time = trucks[i].available_time;
-        sol.truck_details.push_back(info);
-        if (trucks[i].route.size() > 2)
-            sol.routes.push_back(trucks[i].route);
+        info.route.assign(ws.routeNode.begin() + base, ws.routeNode.begin() + base + len);
+        info.arrival_times.assign(ws.routeArr.begin() + base, ws.routeArr.begin() + base + len);
+        info.departure_times.assign(ws.routeDep.begin() + base, ws.routeDep.begin() + base + len);
+        info.completion_time = ws.truckTime[i];
+        if (len > 2)
+            sol.routes.push_back(info.route);
+        sol.truck_details.push_back(std::move(info));
     }
-
-    sol.totalCost = C_max;
-    if (sol.totalPenalty > 1.0) sol.isFeasible = false;
     return sol;
 }
 
+static DecoderWorkspace& threadWorkspace() {
+    static thread_local DecoderWorkspace ws;
+    return ws;
+}
+
+static PDPCost costFromWorkspace(const DecoderWorkspace& ws) {
+    PDPCost cost;
+    cost.totalCost = ws.cmax;
+    cost.totalPenalty = ws.penalty;
+    cost.isFeasible = ws.feasible;
+    return cost;
+}
+
+PDPSolution decodeFromEncoding(const Chromosome& chromo, const PDPData& data, DecoderWorkspace& ws) {
+    simulateEncoding(chromo.sequence, chromo.truck_assign, chromo.drone_assign, chromo.break_bit, data, ws, true);
+    return buildSolution(chromo.sequence, chromo.truck_assign, chromo.drone_assign, chromo.break_bit, data, ws);
+}
+
 PDPSolution decodeFromEncoding(const Chromosome& chromo, const PDPData& data) {
-    AssignmentEncoding enc;
-    enc.truck_assign = chromo.truck_assign;
-    enc.drone_assign = chromo.drone_assign;
-    enc.break_bit = chromo.break_bit;
-    return decodeFromEncoding(chromo.sequence, enc, data);
+    return decodeFromEncoding(chromo, data, threadWorkspace());
+}
+
+PDPCost decodeCostOnly(const Chromosome& chromo, const PDPData& data, DecoderWorkspace& ws) {
+    simulateEncoding(chromo.sequence, chromo.truck_assign, chromo.drone_assign, chromo.break_bit, data, ws, false);
+    return costFromWorkspace(ws);
+}
+
+PDPCost decodeCostOnly(const Chromosome& chromo, const PDPData& data) {
+    return decodeCostOnly(chromo, data, threadWorkspace());
+}
+
+PDPCost buildDecoderCheckpoints(const Chromosome& base, const PDPData& data, DecoderCheckpoints& checkpoints) {
+    DecoderWorkspace& ws = threadWorkspace();
+    simulateEncoding(base.sequence, base.truck_assign, base.drone_assign, base.break_bit,
+                     data, ws, false, &checkpoints);
+    checkpoints.baseCost = costFromWorkspace(ws);
+    return checkpoints.baseCost;
+}
+
+PDPCost decodeCostIncremental(const Chromosome& chromo, const PDPData& data,
+                              const DecoderCheckpoints& checkpoints) {
+    DecoderWorkspace& ws = threadWorkspace();
+    simulateEncoding(chromo.sequence, chromo.truck_assign, chromo.drone_assign, chromo.break_bit,
+                     data, ws, false, nullptr, &checkpoints);
+    return costFromWorkspace(ws);
+}
+
+PDPCost decodeBounded(const Chromosome& chromo, const PDPData& data, double bound,
+                      bool& pruned, double penaltyWeight) {
+    DecoderWorkspace& ws = threadWorkspace();
+    simulateEncoding(chromo.sequence, chromo.truck_assign, chromo.drone_assign, chromo.break_bit,
+                     data, ws, false, nullptr, nullptr, bound, penaltyWeight);
+    pruned = ws.pruned;
+    return costFromWorkspace(ws);
+}
+
+PDPCost decodeBounded(const Chromosome& chromo, const PDPData& data,
+                      const DecoderCheckpoints& checkpoints, double bound,
+                      bool& pruned, double penaltyWeight) {
+    DecoderWorkspace& ws = threadWorkspace();
+    simulateEncoding(chromo.sequence, chromo.truck_assign, chromo.drone_assign, chromo.break_bit,
+                     data, ws, false, nullptr, &checkpoints, bound, penaltyWeight);
+    pruned = ws.pruned;
+    return costFromWorkspace(ws);
+}
+
+// ============ LOWER BOUND ============
+
+template <typename Times>
+static double costLowerBoundWith(const Times& tt, const Chromosome& chromo, const PDPData& data,
+                                 double penaltyWeight) {
+    const vector<int>& seq = chromo.sequence;
+    if (seq.empty()) return penaltyWeight * 1e9;
+
+    DecoderWorkspace& ws = threadWorkspace();
+    ws.prepare(data, (int)seq.size());
+    ws.reserveStamps(1);
+    ws.decodeStamp = ws.nextStamp();  // Pickups seen, per truck (pairStamp)
+    ws.numTrips = 0;
+    fill(ws.activeTrip.begin(), ws.activeTrip.end(), -1);
+    for (int t = 0; t < data.numTrucks; t++) {
+        ws.truckTime[t] = 0.0;        // Earliest the truck can be done so far
+        ws.truckPos[t] = data.depotIndex;
+    }
+
+    const double depotLeg = data.truckNearestTime[data.depotIndex];
+    double penalty = 0.0;
+    for (int i = 0; i < (int)seq.size(); i++) {
+        int v = seq[i];
+        if (!data.isCustomer(v)) continue;
+        const uint8_t kind = data.nodeKind[v];
+        int pairId = data.pairIds[v];
+
+        // Drone trips as in buildDroneTrips
+        bool tripStart = false, tripMember = false;
+        if (data.isDroneEligible(v) && chromo.drone_assign[i] > 0) {
+            int key = chromo.truck_assign[i] * ws.numDrones + chromo.drone_assign[i] - 1;
+            int tidx = ws.activeTrip[key];
+            if (chromo.break_bit[i] == 1 || tidx < 0 || ws.tripSize[tidx] >= ws.tripCap) {
+                tidx = ws.numTrips++;
+                ws.tripSize[tidx] = 1;
+                ws.activeTrip[key] = tidx;
+                tripStart = true;
+            } else {
+                ws.tripSize[tidx]++;
+                tripMember = true;
+            }
+        }
+
+        // Serving truck as in servingTruck
+        int t;
+        if (kind == NODE_DL && pairId > 0) {
+            t = -1;
+            for (int k = 0; k < data.numTrucks && t < 0; k++) {
+                if (ws.pairStamp[(size_t)k * ws.pairSlots + pairId] == ws.decodeStamp) t = k;
+            }
+            if (t < 0) {
+                penalty += 10000;
+                continue;
+            }
+            ws.pairStamp[(size_t)t * ws.pairSlots + pairId] = 0;
+        } else {
+            t = chromo.truck_assign[i];
+            if (t < 0 || t >= data.numTrucks) t = 0;
+        }
+
+        double& time = ws.truckTime[t];
+        bool atDepot = ws.truckPos[t] == data.depotIndex;
+        double ready = (double)data.readyTimes[v];
+        double inbound = data.truckNearestTime[v];
+        double fromDepot = getTruckDistance(tt, data.depotIndex, v) / data.truckSpeed * 60.0;
+
+        if (kind == NODE_DL && pairId > 0) {
+            time += inbound + data.truckServiceTime;
+        } else if (kind == NODE_P) {
+            time = (atDepot ? max(time, ready) + fromDepot : max(time + inbound, ready))
+                   + data.truckServiceTime;
+            if (pairId > 0) ws.pairStamp[(size_t)t * ws.pairSlots + pairId] = ws.decodeStamp;
+        } else if (kind == NODE_D) {
+            // A later trip member is only served if its trip is flown: no bound from it
+            if (tripMember) continue;
+            double viaDepot = max(atDepot ? time : time + depotLeg + data.depotReceiveTime, ready)
+                              + fromDepot + data.truckServiceTime;
+            if (tripStart && data.isDroneReachable(v)) {
+                double droneArrive = ready + data.depotDroneLoadTime +
+                    getDroneDistance(tt, data.depotIndex, v) / data.droneSpeed * 60.0;
+                double rendezvous = max(time + inbound, droneArrive) + data.resupplyTime
+                                    + data.truckServiceTime;
+                time = min(viaDepot, rendezvous);
+            } else {
+                if (tripStart) penalty += 500;  // The drone cannot make the trip
+                time = viaDepot;
+            }
+        } else {
+            continue;
+        }
+        ws.truckPos[t] = v;
+    }
+
+    double C_max = 0.0;
+    for (int t = 0; t < data.numTrucks; t++) {
+        double finish = ws.truckTime[t];
+        if (ws.truckPos[t] != data.depotIndex) finish += depotLeg;
+        C_max = max(C_max, finish);
+    }
+    return C_max + penaltyWeight * penalty;
+}
+
+double costLowerBound(const Chromosome& chromo, const PDPData& data, double penaltyWeight) {
+    double bound = 0.0;
+    withTravelTimes(data, [&](const auto& tt) { bound = costLowerBoundWith(tt, chromo, data, penaltyWeight); });
+    return bound;
 }
 
 // Extract encoding from a greedy-decoded solution
@@ -619,177 +1041,223 @@ PDPSolution runAssignmentLS(
     const vector<int>& seq,
     AssignmentEncoding& enc,
     const PDPData& data,
-    int max_iter
+    int max_iter,
+    ThreadPool* pool,
+    const Deadline& deadline
 ) {
-    PDPSolution best_sol = decodeFromEncoding(seq, enc, data);
-    double best_cost = best_sol.totalCost + best_sol.totalPenalty * 1000.0;
+    // Every candidate differs from the current encoding in a few assignment genes:
+    // resume its decode from the prefix checkpoints of the current one.
+    //
+    // Candidates are not cached: a candidate repeats one seen before only when it
+    // touches the genes of the last applied move (under 1% of them), so any lookup
+    // costs more than the decodes it saves. Memory stays at one copy per scan range.
+    Chromosome current;
+    current.sequence = seq;
+    current.truck_assign = enc.truck_assign;
+    current.drone_assign = enc.drone_assign;
+    current.break_bit = enc.break_bit;
+
+    DecoderCheckpoints checkpoints;
+    PDPCost start = buildDecoderCheckpoints(current, data, checkpoints);
+    double best_cost = start.totalCost + start.totalPenalty * 1000.0;
     int n = (int)seq.size();
+
+    // A drone trip whose first customer the drone cannot reach always takes the
+    // infeasible-trip penalty. firstKeyPos[truck * numDrones + drone - 1] is the first
+    // drone-eligible position of `current` with that truck and drone (n if none): a
+    // position before it, or with break_bit 1, certainly starts a trip.
+    const int numDrones = max(0, data.numDrones);
+    bool anyUnreachable = false;
+    for (int c : seq)
+        if (data.isCustomer(c) && data.isDroneEligible(c) && !data.isDroneReachable(c)) anyUnreachable = true;
+    vector<int> firstKeyPos;
+    auto rebuildFirstKeyPos = [&]() {
+        if (!anyUnreachable) return;
+        firstKeyPos.assign((size_t)max(1, data.numTrucks) * numDrones, n);
+        for (int i = n - 1; i >= 0; i--) {
+            int c = seq[i], d = current.drone_assign[i];
+            if (d > 0 && data.isCustomer(c) && data.isDroneEligible(c))
+                firstKeyPos[(size_t)current.truck_assign[i] * numDrones + (d - 1)] = i;
+        }
+    };
+    // True if drone d at position i (truck t) is sure to be an unreachable rendezvous.
+    // Still sound when the move also takes that drone off one earlier position p: if
+    // p was the first such position the answer is just a conservative false.
+    auto unreachableStart = [&](int i, int t, int d) {
+        int c = seq[i];
+        if (d <= 0 || !anyUnreachable || !data.isDroneEligible(c) || data.isDroneReachable(c)) return false;
+        if (current.break_bit[i] == 1) return true;
+        int first = firstKeyPos[(size_t)t * numDrones + (d - 1)];
+        return first >= i;
+    };
+    rebuildFirstKeyPos();
     // Re-enable sliding window pruning for speed: restricts OP4/OP5 neighborhood
     const int truckSwapWindow = max(8, min(30, n / 3));
     const int droneSwapWindow = max(8, min(30, n / 3));
-    unordered_map<size_t, double> eval_cache;
-    eval_cache.reserve((size_t)n * (size_t)max_iter * 2);
 
     // Precompute DL partner indices for P nodes
     vector<int> dl_partner(n, -1);
-    for (int i = 0; i < n; i++) {
-        int c = seq[i];
-        if (!data.isCustomer(c)) continue;
-        if (data.nodeTypes[c] == "P" && data.pairIds[c] > 0) {
-            int pair_id = data.pairIds[c];
-            for (int j = 0; j < n; j++) {
-                if (j != i && data.isCustomer(seq[j]) &&
-                    data.nodeTypes[seq[j]] == "DL" &&
-                    data.pairIds[seq[j]] == pair_id) {
-                    dl_partner[i] = j;
-                    break;
-                }
-            }
+    {
+        vector<int> pos_of(data.numNodes, -1);
+        for (int j = n - 1; j >= 0; j--)
+            if (data.isCustomer(seq[j])) pos_of[seq[j]] = j;
+        for (int i = 0; i < n; i++) {
+            int c = seq[i];
+            if (!data.isCustomer(c)) continue;
+            if (data.nodeKind[c] == NODE_P && data.pairIds[c] > 0 && data.pairPartner[c] >= 0)
+                dl_partner[i] = pos_of[data.pairPartner[c]];
         }
     }
 
-    auto hashEncoding = [&](const AssignmentEncoding& e) -> size_t {
-        size_t h = 1469598103934665603ULL; // FNV offset basis
-        auto mix = [&](int x) {
-            h ^= (size_t)(x + 1315423911);
-            h *= 1099511628211ULL;
-        };
-        for (int v : e.truck_assign) mix(v);
-        mix(-7);
-        for (int v : e.drone_assign) mix(v);
-        mix(-13);
-        for (int v : e.break_bit) mix(v);
-        return h;
+    // The scan is cut into position ranges (several per thread when there is a pool).
+    // Each range flips genes on a private copy of `current` and records the
+    // candidates that beat the current cost.
+    struct LSMove {
+        int op, i, j, val;
+        double cost;
     };
-
-    auto evalCurrentEncodingCost = [&]() -> double {
-        size_t key = hashEncoding(enc);
-        auto it = eval_cache.find(key);
-        if (it != eval_cache.end()) return it->second;
-        PDPSolution sol = decodeFromEncoding(seq, enc, data);
-        double cost = sol.totalCost + sol.totalPenalty * 1000.0;
-        eval_cache.emplace(key, cost);
-        return cost;
+    struct ScanRange {
+        Chromosome work;
+        vector<LSMove> improving;
     };
+    size_t numRanges = pool ? min((size_t)n, (size_t)pool->size() * 4) : min((size_t)n, (size_t)1);
+    vector<ScanRange> ranges(numRanges);
+
+    auto scanRange = [&](size_t r) {
+        ScanRange& range = ranges[r];
+        Chromosome& work = range.work;
+        work = current;
+        range.improving.clear();
+        // Only a candidate below the range's best so far can be chosen below, so a
+        // checkpoint decode stops as soon as the candidate provably costs more
+        double rangeBest = best_cost;
+        auto flip = [&](int field, int pos, int value) { work.setGene(field, pos, value); };
+        auto evaluate = [&](int op, int i, int j, int val) {
+            bool pruned = false;
+            PDPCost c = decodeBounded(work, data, checkpoints, rangeBest - 0.01, pruned, 1000.0);
+            if (pruned) return;
+            double cost = c.totalCost + c.totalPenalty * 1000.0;
+            // Anything else can never be chosen below
+            if (cost < rangeBest - 0.01) {
+                range.improving.push_back(LSMove{op, i, j, val, cost});
+                rangeBest = cost;
+            }
+        };
 
-    for (int iter = 0; iter < max_iter; iter++) {
-        // Best-improvement: find the best move across all operators
-        double iter_best_cost = best_cost;
-        int best_op = -1, best_i = -1, best_j = -1, best_val = -1;
-
-        for (int i = 0; i < n; i++) {
+        int iEnd = (int)((size_t)n * (r + 1) / numRanges);
+        for (int i = (int)((size_t)n * r / numRanges); i < iEnd; i++) {
             int c = seq[i];
             if (!data.isCustomer(c)) continue;
-            string ctype = data.nodeTypes[c];
+            const uint8_t ckind = data.nodeKind[c];
 
             // === OP1: Flip truck assignment (P and D only, skip DL) ===
-            if (ctype != "DL") {
-                int old_truck = enc.truck_assign[i];
+            if (ckind != NODE_DL) {
+                int old_truck = work.truck_assign[i];
                 int di = dl_partner[i];
-                int dl_old = (di >= 0) ? enc.truck_assign[di] : -1;
+                int dl_old = (di >= 0) ? work.truck_assign[di] : -1;
 
                 for (int t = 0; t < data.numTrucks; t++) {
                     if (t == old_truck) continue;
-                    enc.truck_assign[i] = t;
-                    if (di >= 0) enc.truck_assign[di] = t;
+                    flip(FIELD_TRUCK, i, t);
+                    if (di >= 0) flip(FIELD_TRUCK, di, t);
 
-                    double cost = evalCurrentEncodingCost();
-                    if (cost < iter_best_cost - 0.01) {
-                        iter_best_cost = cost;
-                        best_op = 1; best_i = i; best_val = t;
-                    }
+                    evaluate(1, i, -1, t);
 
-                    enc.truck_assign[i] = old_truck;
-                    if (di >= 0) enc.truck_assign[di] = dl_old;
+                    flip(FIELD_TRUCK, i, old_truck);
+                    if (di >= 0) flip(FIELD_TRUCK, di, dl_old);
                 }
             }
 
             // === OP2: Flip drone/depot (type D only) ===
-            if (ctype == "D" && data.readyTimes[c] > 0) {
-                int old_drone = enc.drone_assign[i];
+            if (ckind == NODE_D) {
+                int old_drone = work.drone_assign[i];
                 for (int d = 0; d <= data.numDrones; d++) {
                     if (d == old_drone) continue;
-                    enc.drone_assign[i] = d;
-
-                    double cost = evalCurrentEncodingCost();
-                    if (cost < iter_best_cost - 0.01) {
-                        iter_best_cost = cost;
-                        best_op = 2; best_i = i; best_val = d;
-                    }
-
-                    enc.drone_assign[i] = old_drone;
+                    if (unreachableStart(i, work.truck_assign[i], d)) continue;
+                    flip(FIELD_DRONE, i, d);
+                    evaluate(2, i, -1, d);
+                    flip(FIELD_DRONE, i, old_drone);
                 }
             }
 
             // === OP3: Flip break bit (type D with drone > 0) ===
-            if (ctype == "D" && data.readyTimes[c] > 0 && enc.drone_assign[i] > 0) {
-                enc.break_bit[i] = 1 - enc.break_bit[i];
-
-                double cost = evalCurrentEncodingCost();
-                if (cost < iter_best_cost - 0.01) {
-                    iter_best_cost = cost;
-                    best_op = 3; best_i = i;
-                }
-
-                enc.break_bit[i] = 1 - enc.break_bit[i];  // revert
+            if (ckind == NODE_D && work.drone_assign[i] > 0) {
+                flip(FIELD_BREAK, i, 1 - work.break_bit[i]);
+                evaluate(3, i, -1, -1);
+                flip(FIELD_BREAK, i, 1 - work.break_bit[i]);  // revert
             }
 
             // === OP4: Swap truck assignment between two customers ===
-            if (ctype != "DL") {
+            if (ckind != NODE_DL) {
                 int jLimit = min(n, i + 1 + truckSwapWindow);
                 for (int j = i + 1; j < jLimit; j++) {
                     int c2 = seq[j];
                     if (!data.isCustomer(c2)) continue;
-                    if (data.nodeTypes[c2] == "DL") continue;
-                    if (enc.truck_assign[i] == enc.truck_assign[j]) continue;
+                    if (data.nodeKind[c2] == NODE_DL) continue;
+                    if (work.truck_assign[i] == work.truck_assign[j]) continue;
 
                     // Swap trucks
-                    int ti = enc.truck_assign[i], tj = enc.truck_assign[j];
+                    int ti = work.truck_assign[i], tj = work.truck_assign[j];
                     int di = dl_partner[i], dj = dl_partner[j];
-                    int di_old = (di >= 0) ? enc.truck_assign[di] : -1;
-                    int dj_old = (dj >= 0) ? enc.truck_assign[dj] : -1;
-
-                    enc.truck_assign[i] = tj;
-                    enc.truck_assign[j] = ti;
-                    if (di >= 0) enc.truck_assign[di] = tj;
-                    if (dj >= 0) enc.truck_assign[dj] = ti;
-
-                    double cost = evalCurrentEncodingCost();
-                    if (cost < iter_best_cost - 0.01) {
-                        iter_best_cost = cost;
-                        best_op = 4; best_i = i; best_j = j;
-                    }
+                    int di_old = (di >= 0) ? work.truck_assign[di] : -1;
+                    int dj_old = (dj >= 0) ? work.truck_assign[dj] : -1;
+
+                    flip(FIELD_TRUCK, i, tj);
+                    flip(FIELD_TRUCK, j, ti);
+                    if (di >= 0) flip(FIELD_TRUCK, di, tj);
+                    if (dj >= 0) flip(FIELD_TRUCK, dj, ti);
+
+                    evaluate(4, i, j, -1);
 
                     // Revert
-                    enc.truck_assign[i] = ti;
-                    enc.truck_assign[j] = tj;
-                    if (di >= 0) enc.truck_assign[di] = di_old;
-                    if (dj >= 0) enc.truck_assign[dj] = dj_old;
+                    flip(FIELD_TRUCK, i, ti);
+                    flip(FIELD_TRUCK, j, tj);
+                    if (di >= 0) flip(FIELD_TRUCK, di, di_old);
+                    if (dj >= 0) flip(FIELD_TRUCK, dj, dj_old);
                 }
             }
 
             // === OP5: Swap drone assignment between two D customers ===
-            if (ctype == "D" && data.readyTimes[c] > 0) {
+            if (ckind == NODE_D) {
                 int jLimit = min(n, i + 1 + droneSwapWindow);
                 for (int j = i + 1; j < jLimit; j++) {
                     int c2 = seq[j];
                     if (!data.isCustomer(c2)) continue;
-                    if (data.nodeTypes[c2] != "D" || data.readyTimes[c2] <= 0) continue;
-                    if (enc.drone_assign[i] == enc.drone_assign[j]) continue;
+                    if (!data.isDroneEligible(c2)) continue;
+                    if (work.drone_assign[i] == work.drone_assign[j]) continue;
 
-                    int di_val = enc.drone_assign[i], dj_val = enc.drone_assign[j];
-                    enc.drone_assign[i] = dj_val;
-                    enc.drone_assign[j] = di_val;
+                    int di_val = work.drone_assign[i], dj_val = work.drone_assign[j];
+                    if (unreachableStart(i, work.truck_assign[i], dj_val) ||
+                        unreachableStart(j, work.truck_assign[j], di_val)) continue;
+                    flip(FIELD_DRONE, i, dj_val);
+                    flip(FIELD_DRONE, j, di_val);
 
-                    double cost = evalCurrentEncodingCost();
-                    if (cost < iter_best_cost - 0.01) {
-                        iter_best_cost = cost;
-                        best_op = 5; best_i = i; best_j = j;
-                    }
+                    evaluate(5, i, j, -1);
 
                     // Revert
-                    enc.drone_assign[i] = di_val;
-                    enc.drone_assign[j] = dj_val;
+                    flip(FIELD_DRONE, i, di_val);
+                    flip(FIELD_DRONE, j, dj_val);
+                }
+            }
+        }
+    };
+
+    for (int iter = 0; iter < max_iter; iter++) {
+        if (pool) {
+            pool->parallelFor(numRanges, scanRange);
+        } else {
+            for (size_t r = 0; r < numRanges; r++) scanRange(r);
+        }
+
+        // Best-improvement: reduce in scan order, so the chosen move (ties included)
+        // is the one a serial scan would pick, whatever the thread count
+        double iter_best_cost = best_cost;
+        int best_op = -1, best_i = -1, best_j = -1, best_val = -1;
+        for (const ScanRange& range : ranges) {
+            for (const LSMove& m : range.improving) {
+                if (m.cost < iter_best_cost - 0.01) {
+                    iter_best_cost = m.cost;
+                    best_op = m.op; best_i = m.i; best_j = m.j; best_val = m.val;
                 }
             }
         }
@@ -798,32 +1266,38 @@ PDPSolution runAssignmentLS(
         if (best_op < 0) break;  // no improving move found
 
         if (best_op == 1) {
-            enc.truck_assign[best_i] = best_val;
+            current.setGene(FIELD_TRUCK, best_i, best_val);
             int di = dl_partner[best_i];
-            if (di >= 0) enc.truck_assign[di] = best_val;
+            if (di >= 0) current.setGene(FIELD_TRUCK, di, best_val);
         } else if (best_op == 2) {
-            enc.drone_assign[best_i] = best_val;
+            current.setGene(FIELD_DRONE, best_i, best_val);
         } else if (best_op == 3) {
-            enc.break_bit[best_i] = 1 - enc.break_bit[best_i];
+            current.setGene(FIELD_BREAK, best_i, 1 - current.break_bit[best_i]);
         } else if (best_op == 4) {
-            int ti = enc.truck_assign[best_i], tj = enc.truck_assign[best_j];
-            enc.truck_assign[best_i] = tj;
-            enc.truck_assign[best_j] = ti;
+            int ti = current.truck_assign[best_i], tj = current.truck_assign[best_j];
+            current.setGene(FIELD_TRUCK, best_i, tj);
+            current.setGene(FIELD_TRUCK, best_j, ti);
             int di = dl_partner[best_i], dj = dl_partner[best_j];
-            if (di >= 0) enc.truck_assign[di] = tj;
-            if (dj >= 0) enc.truck_assign[dj] = ti;
+            if (di >= 0) current.setGene(FIELD_TRUCK, di, tj);
+            if (dj >= 0) current.setGene(FIELD_TRUCK, dj, ti);
         } else if (best_op == 5) {
-            int di_val = enc.drone_assign[best_i], dj_val = enc.drone_assign[best_j];
-            enc.drone_assign[best_i] = dj_val;
-            enc.drone_assign[best_j] = di_val;
+            int di_val = current.drone_assign[best_i], dj_val = current.drone_assign[best_j];
+            current.setGene(FIELD_DRONE, best_i, dj_val);
+            current.setGene(FIELD_DRONE, best_j, di_val);
         }
 
-        // Decode only once after committing the best move.
-        best_sol = decodeFromEncoding(seq, enc, data);
-        best_cost = best_sol.totalCost + best_sol.totalPenalty * 1000.0;
+        best_cost = iter_best_cost;
+        if (deadline.expired()) break;
+        buildDecoderCheckpoints(current, data, checkpoints);
+        rebuildFirstKeyPos();
     }
 
-    return best_sol;
+    enc.truck_assign = current.truck_assign;
+    enc.drone_assign = current.drone_assign;
+    enc.break_bit = current.break_bit;
+
+    // Full solution only for the final (accepted) encoding.
+    return decodeFromEncoding(current, data);
 }
 
 // =========================================================
@@ -833,8 +1307,8 @@ PDPSolution runAssignmentLS(
 /**
  * @brief Wrapper for decodeFromEncoding with solution caching.
  * 
- * Implements O(1) cache lookup using SequenceHash on vector<int>.
- * Automatically clears cache when memory limit is exceeded.
+ * Goes through SolutionCache::getOrCompute: O(1) lookup by fingerprint, and
+ * concurrent misses on the same chromosome decode it only once.
  * 
  * Cache hit: Returns cached solution copy (O(1) + copy time)
  * Cache miss: Calls decodeFromEncoding, stores in cache (O(decode) + hash ops)
@@ -872,15 +1346,45 @@ PDPSolution evaluateWithCache(
     const PDPData& data,
     SolutionCache& cache
 ) {
-    if (cache.contains(chromo)) {
+    // Compact caches only know the cost: a known chromosome is re-decoded for its details
+    return cache.getOrCompute(chromo, [&]() { return decodeFromEncoding(chromo, data); });
+}
+
+PDPCost evaluateCostWithCache(
+    const Chromosome& chromo,
+    const PDPData& data,
+    SolutionCache& cache
+) {
+    return cache.getOrComputeCost(chromo, [&]() { return decodeCostOnly(chromo, data); });
+}
+
+PDPCost evaluateCostWithCache(
+    const Chromosome& chromo,
+    const PDPData& data,
+    SolutionCache& cache,
+    const DecoderCheckpoints& checkpoints
+) {
+    return cache.getOrComputeCost(chromo, [&]() { return decodeCostIncremental(chromo, data, checkpoints); });
+}
+
+PDPCost evaluateCostWithCache(
+    const Chromosome& chromo,
+    const PDPData& data,
+    SolutionCache& cache,
+    const DecoderCheckpoints& checkpoints,
+    double bound,
+    bool& pruned
+) {
+    PDPCost cost;
+    if (cache.findCost(chromo, cost)) {
         cache.recordHit();
-        return cache.get(chromo);
+        pruned = false;
+        return cost;
     }
-
     cache.recordMiss();
-    PDPSolution solution = decodeFromEncoding(chromo, data);
-    cache.put(chromo, solution);
-    return solution;
+    cost = decodeBounded(chromo, data, checkpoints, bound, pruned);
+    if (!pruned) cache.putCost(chromo, cost);
+    return cost;
 }
 
 // =========================================================
@@ -3,6 +3,7 @@
 
 #include "pdp_types.h"
 #include "pdp_cache.h"
+#include "pdp_parallel.h"
 #include <vector>
 #include <algorithm>
 
@@ -44,6 +45,8 @@
  * @param cache Reference to SolutionCache object maintaining state across evals
  * 
  * @return PDPSolution with all details (truck_details, resupply_events accessible for post-processing)
+ *
+ * Safe to call from several threads sharing one cache.
  */
 PDPSolution evaluateWithCache(
     const std::vector<int>& seq,
@@ -58,6 +61,40 @@ PDPSolution evaluateWithCache(
     SolutionCache& cache
 );
 
+/**
+ * @brief Cost-only counterpart of evaluateWithCache for screening candidates.
+ *
+ * Answers from either cache table; on a miss runs decodeCostOnly and stores
+ * only the objective values. Use evaluateWithCache once a candidate is accepted
+ * and its routes/events are needed.
+ */
+PDPCost evaluateCostWithCache(
+    const Chromosome& chromo,
+    const PDPData& data,
+    SolutionCache& cache
+);
+
+struct DecoderCheckpoints;
+
+// Same, but misses are decoded incrementally from the checkpoints of a base chromosome.
+PDPCost evaluateCostWithCache(
+    const Chromosome& chromo,
+    const PDPData& data,
+    SolutionCache& cache,
+    const DecoderCheckpoints& checkpoints
+);
+
+// Same, but a miss is decoded with decodeBounded (cost + penalty against `bound`).
+// A pruned candidate is not cached and its returned cost is only a lower bound.
+PDPCost evaluateCostWithCache(
+    const Chromosome& chromo,
+    const PDPData& data,
+    SolutionCache& cache,
+    const DecoderCheckpoints& checkpoints,
+    double bound,
+    bool& pruned
+);
+
 // Assignment encoding for Local Search post-processing
 struct AssignmentEncoding {
     std::vector<int> truck_assign;
@@ -65,20 +102,240 @@ struct AssignmentEncoding {
     std::vector<int> break_bit;
 };
 
+/**
+ * @brief Reusable scratch state for decodeFromEncoding.
+ *
+ * Holds the truck/drone simulation state in flat arrays that are sized once per
+ * instance (prepare) and reused across calls, instead of per-call TruckState
+ * sets and customer->trip maps. A steady-state decode therefore does no heap
+ * allocation until the result is copied out into a PDPSolution.
+ *
+ * Membership sets (picked-up pairs, cargo on truck, processed customers) are
+ * stamp arrays: an entry is "in the set" when it equals the current stamp, so
+ * clearing a set is a single counter increment.
+ *
+ * NOT thread-safe: use one workspace per thread.
+ */
+struct DecoderWorkspace {
+    // Drone resupply event recorded during simulation (customers live in the trip arrays)
+    struct Event {
+        int trip;
+        int truck_id;
+        int drone_id;
+        int resupply_point;
+        double drone_depart_time;
+        double drone_arrive_time;
+        double truck_arrive_time;
+        double resupply_start_time;
+        double resupply_end_time;
+        double drone_return_time;
+        double total_flight_time;
+        double truck_delivery_end;
+    };
+
+    // === SIZING ===
+    int numNodes = 0;
+    int numTrucks = 0;
+    int numDrones = 0;
+    int seqCap = 0;          // Longest sequence the buffers can hold
+    int tripCap = 1;         // Max customers per drone trip (PDPData::getDroneCapacity)
+    int routeCap = 0;        // Max route entries per truck (depot + 2 per customer + return)
+    int pairSlots = 1;       // max pairId + 1
+
+    // === TRUCK STATE (per truck) ===
+    std::vector<double> truckTime;   // Available time
+    std::vector<int> truckPos;       // Current node
+    std::vector<double> truckLoad;   // Current load
+    std::vector<unsigned> cargoEpoch; // Stamp that marks "on this truck" in cargoStamp
+
+    // Routes: truck t owns entries [t * routeCap, t * routeCap + routeLen[t])
+    std::vector<int> routeNode;
+    std::vector<double> routeArr;
+    std::vector<double> routeDep;
+    std::vector<int> routeLen;
+
+    // Stamp sets: pairStamp[t * pairSlots + pairId], cargoStamp[t * numNodes + node], processedStamp[node]
+    std::vector<unsigned> pairStamp;
+    std::vector<unsigned> cargoStamp;
+    std::vector<unsigned> processedStamp;
+    unsigned stamp = 0;
+    unsigned decodeStamp = 0;
+
+    // === DRONE TRIPS (built from the encoding) ===
+    int numTrips = 0;
+    std::vector<int> tripTruck;
+    std::vector<int> tripDrone;
+    std::vector<int> tripSize;
+    std::vector<int> tripCust;       // trip k owns [k * tripCap, k * tripCap + tripSize[k])
+    std::vector<int> tripFirstPos;   // sequence position of the trip's first / last customer
+    std::vector<int> tripLastPos;
+    std::vector<int> activeTrip;     // [truck * numDrones + drone] -> open trip or -1
+    std::vector<int> custTrip;       // node -> trip containing it (-1 if none)
+    std::vector<int> firstCustTrip;  // node -> trip it starts (-1 if none)
+
+    // === DRONE STATE (per drone) ===
+    std::vector<double> droneAvail;
+    std::vector<double> droneDone;
+
+    // === RESULT ===
+    int numEvents = 0;
+    std::vector<Event> events;
+    double cmax = 0.0;
+    double penalty = 0.0;
+    bool feasible = true;
+    bool pruned = false;     // Bounded decode stopped early: cmax / penalty are lower bounds
+
+    /**
+     * @brief Size the buffers for an instance and sequence length.
+     * Only reallocates when the instance dimensions grow.
+     */
+    void prepare(const PDPData& data, int seqLen);
+
+    /**
+     * @brief Make room for `count` more stamps, wiping all stamp arrays if the
+     * counter would wrap. Called once at the start of each decode.
+     */
+    void reserveStamps(unsigned count);
+
+    unsigned nextStamp() { return ++stamp; }
+};
+
+/**
+ * @brief Prefix snapshots of a cost-only decode, for re-evaluating neighbors.
+ *
+ * buildDecoderCheckpoints decodes a base chromosome and snapshots the simulation
+ * state (trucks, drones, cargo/pair/processed sets, C_max, penalty) every
+ * `interval` positions. decodeCostIncremental then evaluates a neighbor by
+ * restoring the last snapshot before its first changed gene and simulating only
+ * the suffix. A drone trip opened before that gene whose member list changed
+ * moves the restart back to the trip's first customer, since the trip is
+ * scheduled there. The closing C_max / depot-return pass always runs on the resumed state.
+ *
+ * Results are identical to decodeCostOnly. Any snapshot may be used from any
+ * thread (read-only), as long as the instance is the same.
+ */
+struct DecoderCheckpoints {
+    int interval = 4;        // Positions between snapshots
+
+    // Base encoding
+    std::vector<int> seq;
+    std::vector<int> truck_assign;
+    std::vector<int> drone_assign;
+    std::vector<int> break_bit;
+    // Drone trips of the base (numbered by first position, customers with tripCap stride)
+    std::vector<int> tripLastPos;
+    std::vector<int> tripSize;
+    std::vector<int> tripCust;
+    PDPCost baseCost;
+
+    // Workspace shape the snapshots were taken with
+    int numNodes = 0;
+    int numTrucks = 0;
+    int numDrones = 0;
+    int pairSlots = 0;
+    int tripCap = 0;
+    unsigned decodeStamp = 0;
+    unsigned stampHigh = 0;  // Largest stamp in any snapshot
+
+    // Snapshot s = state before position (s + 1) * interval
+    int numSaved = 0;
+    std::vector<double> scalars;     // C_max, penalty, feasible (3 per slot)
+    std::vector<double> truckTime;
+    std::vector<int> truckPos;
+    std::vector<double> truckLoad;
+    std::vector<unsigned> cargoEpoch;
+    std::vector<double> droneAvail;
+    std::vector<double> droneDone;
+    std::vector<unsigned> cargoStamp;
+    std::vector<unsigned> pairStamp;
+    std::vector<unsigned> processedStamp;
+};
+
 // Decode using explicit encoding. This is the intended fitness implementation.
+// Uses a thread_local DecoderWorkspace.
 PDPSolution decodeFromEncoding(const Chromosome& chromo, const PDPData& data);
 
+// Same as above with a caller-owned workspace (one per thread).
+PDPSolution decodeFromEncoding(const Chromosome& chromo, const PDPData& data, DecoderWorkspace& ws);
+
+/**
+ * @brief Same simulation as decodeFromEncoding, but returns only C_max, penalty and
+ * feasibility. No routes, events or sequence copies are built, so this is the
+ * entry point for fitness screening (GA offspring, tabu neighborhoods, assignment LS).
+ */
+PDPCost decodeCostOnly(const Chromosome& chromo, const PDPData& data);
+
+PDPCost decodeCostOnly(const Chromosome& chromo, const PDPData& data, DecoderWorkspace& ws);
+
+/**
+ * @brief decodeCostOnly of `base` that also fills `checkpoints` for incremental
+ * re-evaluation of its neighbors. Returns (and stores) the base cost.
+ */
+PDPCost buildDecoderCheckpoints(const Chromosome& base, const PDPData& data, DecoderCheckpoints& checkpoints);
+
+/**
+ * @brief Cost of `chromo` re-simulated from the last checkpoint of `checkpoints`
+ * before its first difference to the base. Falls back to a full decode when no
+ * checkpoint applies (different length, change near the front, ...).
+ */
+PDPCost decodeCostIncremental(const Chromosome& chromo, const PDPData& data,
+                              const DecoderCheckpoints& checkpoints);
+
+/**
+ * @brief decodeCostOnly that gives up as soon as `chromo` provably costs more than
+ * `bound`, for scans that only need the candidates beating a known cost.
+ *
+ * The objective is totalCost + penaltyWeight * totalPenalty. After every customer
+ * the decode checks a lower bound on it: the makespan and penalty so far, with the
+ * truck just moved counted as back at the depot no sooner than its shortest leg
+ * there (PDPData::truckNearestTime). Once that passes `bound`, it stops and sets
+ * `pruned`; the returned cost is then the lower bound (isFeasible = false), never
+ * an exact cost. Otherwise the result is identical to decodeCostOnly.
+ */
+PDPCost decodeBounded(const Chromosome& chromo, const PDPData& data, double bound,
+                      bool& pruned, double penaltyWeight = 1.0);
+
+// Same, resumed from the checkpoints of a base chromosome like decodeCostIncremental
+PDPCost decodeBounded(const Chromosome& chromo, const PDPData& data,
+                      const DecoderCheckpoints& checkpoints, double bound,
+                      bool& pruned, double penaltyWeight = 1.0);
+
+/**
+ * @brief O(n) lower bound on totalCost + penaltyWeight * totalPenalty of `chromo`,
+ * without simulating it (the decoded cost is never below it).
+ *
+ * Walks the sequence once with the decoder's serving rules and keeps, per truck,
+ * the earliest time it can be done so far: every customer the truck must visit
+ * costs at least its cheapest inbound leg (PDPData::truckNearestTime) plus the
+ * service time and cannot start before its ready time (plus the depot leg for a
+ * depot return, or the drone's depot-to-rendezvous flight for a trip start,
+ * whichever of the two is earlier). Drone waiting, capacity and later trip
+ * members are ignored. A truck that moved also needs its shortest leg back to
+ * the depot. Penalties that are certain are included: a DL without an earlier
+ * pickup and a drone trip starting out of the drone's reach.
+ *
+ * Uses the thread's decoder workspace; penaltyWeight = 0 bounds C_max alone.
+ */
+double costLowerBound(const Chromosome& chromo, const PDPData& data, double penaltyWeight = 1.0);
+
 AssignmentEncoding initFromSolution(
     const std::vector<int>& seq,
     const PDPSolution& sol,
     const PDPData& data
 );
 
+// Best-improvement assignment LS from enc (updated in place). pool: scans each
+// neighborhood in parallel, with the same result as a serial scan (nullptr = serial).
+// Candidates that certainly start a drone trip at a customer the drone cannot reach
+// (PDPData::isDroneReachable) are skipped without a decode. Stops after the iteration
+// during which deadline expires.
 PDPSolution runAssignmentLS(
     const std::vector<int>& seq,
     AssignmentEncoding& enc,
     const PDPData& data,
-    int max_iter
+    int max_iter,
+    ThreadPool* pool = nullptr,
+    const Deadline& deadline = Deadline()
 );
 
 // Convenience: run assignment LS on a decoded solution
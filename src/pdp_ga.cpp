@@ -4,6 +4,8 @@
 #include "pdp_fitness.h"
 #include "pdp_cache.h"
 #include "pdp_init.h"
+#include "pdp_parallel.h"
+#include "pdp_migration.h"
 #include <algorithm>
 #include <random>
 #include <map>
@@ -15,6 +17,10 @@
 #include <climits>
 #include <numeric>
 #include <unordered_set>
+#include <array>
+#include <memory>
+#include <sstream>
+#include <functional>
 
 using namespace std;
 
@@ -114,34 +120,223 @@ struct AdaptiveParams {
     }
 };
 
-struct OnlineSurrogate {
-    int n = 0;
-    double sumX = 0.0;
-    double sumY = 0.0;
-    double sumXX = 0.0;
-    double sumXY = 0.0;
+// ============ SURROGATE MODEL ============
+// Ridge regression from cheap chromosome features to log(fitness), fitted on a
+// sliding window of decoded offspring. Used to rank offspring for decoding and
+// to estimate the fitness of the ones that are skipped.
+
+enum SurrogateFeature {
+    SF_BIAS = 0,
+    SF_PARENT,          // log of the better parent's fitness
+    SF_ELITE_OVERLAP,   // Share of sequence edges also used by an elite
+    SF_DRONE_TRIPS,     // Drone trips per customer
+    SF_LOAD_BALANCE,    // Customers on the busiest truck / mean per truck
+    SF_LOWER_BOUND,     // log of costLowerBound
+    SF_COUNT
+};
+
+// Successor of every node in the elite sequences (-1 = none), one row per elite
+struct EliteEdges {
+    int numNodes = 0;
+    vector<int> succ;
+
+    void build(const vector<const vector<int>*>& elites, int nodes) {
+        numNodes = nodes;
+        succ.assign(elites.size() * (size_t)nodes, -1);
+        for (size_t e = 0; e < elites.size(); ++e) {
+            const vector<int>& seq = *elites[e];
+            for (size_t i = 0; i + 1 < seq.size(); ++i)
+                succ[e * nodes + seq[i]] = seq[i + 1];
+        }
+    }
+
+    double overlap(const vector<int>& seq) const {
+        size_t numElites = numNodes > 0 ? succ.size() / numNodes : 0;
+        if (seq.size() < 2 || numElites == 0) return 0.0;
+        int shared = 0;
+        for (size_t i = 0; i + 1 < seq.size(); ++i) {
+            for (size_t e = 0; e < numElites; ++e) {
+                if (succ[e * numNodes + seq[i]] == seq[i + 1]) {
+                    shared++;
+                    break;
+                }
+            }
+        }
+        return (double)shared / (seq.size() - 1);
+    }
+};
 
-    void update(double x, double y) {
+// O(n) features of one offspring (lowerBound: its costLowerBound)
+static void surrogateFeatures(const Chromosome& c, double parentFitness, double lowerBound,
+                              const EliteEdges& elites, const PDPData& data, double* x) {
+    int n = (int)c.sequence.size();
+    int T = max(1, data.numTrucks);
+    int D = max(1, data.numDrones);
+    vector<int> load(T, 0);
+    vector<char> activeTrip((size_t)T * D, 0);
+    int trips = 0;
+    for (int i = 0; i < n; ++i) {
+        int v = c.sequence[i];
+        int t = c.truck_assign[i];
+        if (t < 0 || t >= T) t = 0;
+        load[t]++;
+        int d = c.drone_assign[i];
+        if (d > 0 && d <= D && data.isCustomer(v) && data.isDroneEligible(v)) {
+            char& active = activeTrip[(size_t)t * D + d - 1];
+            if (c.break_bit[i] == 1 || !active) {
+                trips++;
+                active = 1;
+            }
+        }
+    }
+    x[SF_BIAS] = 1.0;
+    x[SF_PARENT] = log(max(1.0, parentFitness));
+    x[SF_ELITE_OVERLAP] = elites.overlap(c.sequence);
+    x[SF_DRONE_TRIPS] = n > 0 ? (double)trips / n : 0.0;
+    x[SF_LOAD_BALANCE] = n > 0 ? *max_element(load.begin(), load.end()) * (double)T / n : 1.0;
+    x[SF_LOWER_BOUND] = log(max(1.0, lowerBound));
+}
+
+// Spearman rank correlation (average ranks for ties); 0 for fewer than 3 pairs
+static double spearmanRankCorrelation(const vector<double>& a, const vector<double>& b) {
+    int m = (int)a.size();
+    if (m < 3 || (int)b.size() != m) return 0.0;
+    auto ranks = [m](const vector<double>& v) {
+        vector<int> order(m);
+        iota(order.begin(), order.end(), 0);
+        sort(order.begin(), order.end(), [&v](int x, int y) { return v[x] < v[y]; });
+        vector<double> r(m);
+        for (int i = 0; i < m;) {
+            int j = i;
+            while (j + 1 < m && v[order[j + 1]] == v[order[i]]) j++;
+            for (int k = i; k <= j; ++k) r[order[k]] = 0.5 * (i + j);
+            i = j + 1;
+        }
+        return r;
+    };
+    vector<double> ra = ranks(a), rb = ranks(b);
+    double mean = 0.5 * (m - 1);
+    double sab = 0.0, saa = 0.0, sbb = 0.0;
+    for (int i = 0; i < m; ++i) {
+        sab += (ra[i] - mean) * (rb[i] - mean);
+        saa += (ra[i] - mean) * (ra[i] - mean);
+        sbb += (rb[i] - mean) * (rb[i] - mean);
+    }
+    if (saa <= 0.0 || sbb <= 0.0) return 0.0;
+    return sab / sqrt(saa * sbb);
+}
+
+struct SurrogateModel {
+    static const int WINDOW = 256;      // Most recent decoded samples kept
+    static const int MIN_SAMPLES = 60;  // Samples before predictions are used
+    static constexpr double RIDGE = 1.0;
+
+    vector<array<double, SF_COUNT>> samples;  // Ring buffer of features
+    vector<double> targets;                   // log(fitness) of each sample
+    int next = 0;
+    long long n = 0;                          // Samples seen in total
+    double fitnessSum = 0.0;                  // Over all n samples
+
+    array<double, SF_COUNT> mean{}, scale{}, weight{};
+    bool fitted = false;
+
+    double rankCorrelation = 0.0;      // Smoothed Spearman rho of prediction vs decode
+    double lastRankCorrelation = 0.0;  // Same, last generation only
+    bool measured = false;
+
+    void update(const double* x, double fitness) {
+        array<double, SF_COUNT> row;
+        copy(x, x + SF_COUNT, row.begin());
+        double y = log(max(1.0, fitness));
+        if ((int)samples.size() < WINDOW) {
+            samples.push_back(row);
+            targets.push_back(y);
+        } else {
+            samples[next] = row;
+            targets[next] = y;
+        }
+        next = (next + 1) % WINDOW;
         n++;
-        sumX += x;
-        sumY += y;
-        sumXX += x * x;
-        sumXY += x * y;
+        if (isfinite(fitness)) fitnessSum += fitness;
+    }
+
+    // Average decoded fitness over the whole run. A skipped child is estimated no
+    // better than this: it then ranks behind the good decoded children but ahead
+    // of the heavily penalized ones, which keeps it in the gene pool.
+    double meanFitness() const {
+        return n > 0 ? fitnessSum / n : 0.0;
     }
 
     bool ready() const {
-        return n >= 30;
+        return fitted && (int)samples.size() >= MIN_SAMPLES;
     }
 
-    double predict(double x, double fallback) const {
-        if (n < 2) return fallback;
-        double denom = n * sumXX - sumX * sumX;
-        if (fabs(denom) < 1e-9) return fallback;
-        double a = (n * sumXY - sumX * sumY) / denom;
-        double b = (sumY - a * sumX) / n;
-        double y = a * x + b;
-        if (!isfinite(y)) return fallback;
-        return y;
+    // Refit on the current window: standardized features, unpenalized bias
+    void fit() {
+        int m = (int)samples.size();
+        fitted = false;
+        if (m < MIN_SAMPLES) return;
+        const int d = SF_COUNT;
+        mean.fill(0.0);
+        scale.fill(1.0);
+        for (int f = 1; f < d; ++f) {
+            double s = 0.0, ss = 0.0;
+            for (int r = 0; r < m; ++r) {
+                s += samples[r][f];
+                ss += samples[r][f] * samples[r][f];
+            }
+            mean[f] = s / m;
+            double var = ss / m - mean[f] * mean[f];
+            scale[f] = var > 1e-12 ? sqrt(var) : 0.0;  // 0 = constant, dropped
+        }
+        double A[SF_COUNT][SF_COUNT + 1] = {};
+        for (int r = 0; r < m; ++r) {
+            double z[SF_COUNT];
+            standardize(samples[r].data(), z);
+            for (int i = 0; i < d; ++i) {
+                for (int j = 0; j < d; ++j) A[i][j] += z[i] * z[j];
+                A[i][d] += z[i] * targets[r];
+            }
+        }
+        for (int i = 1; i < d; ++i) A[i][i] += RIDGE;
+        // Gaussian elimination with partial pivoting
+        for (int col = 0; col < d; ++col) {
+            int piv = col;
+            for (int r = col + 1; r < d; ++r)
+                if (fabs(A[r][col]) > fabs(A[piv][col])) piv = r;
+            if (fabs(A[piv][col]) < 1e-12) return;
+            if (piv != col) swap(A[piv], A[col]);
+            for (int r = 0; r < d; ++r) {
+                if (r == col) continue;
+                double factor = A[r][col] / A[col][col];
+                for (int c = col; c <= d; ++c) A[r][c] -= factor * A[col][c];
+            }
+        }
+        for (int i = 0; i < d; ++i) weight[i] = A[i][d] / A[i][i];
+        fitted = true;
+    }
+
+    double predict(const double* x, double fallback) const {
+        if (!ready()) return fallback;
+        double z[SF_COUNT];
+        standardize(x, z);
+        double y = 0.0;
+        for (int f = 0; f < SF_COUNT; ++f) y += weight[f] * z[f];
+        y = exp(y);
+        return isfinite(y) ? y : fallback;
+    }
+
+    void recordRankCorrelation(double rho) {
+        rankCorrelation = measured ? 0.8 * rankCorrelation + 0.2 * rho : rho;
+        lastRankCorrelation = rho;
+        measured = true;
+    }
+
+private:
+    void standardize(const double* x, double* z) const {
+        z[0] = 1.0;
+        for (int f = 1; f < SF_COUNT; ++f)
+            z[f] = scale[f] > 0.0 ? (x[f] - mean[f]) / scale[f] : 0.0;
     }
 };
 
@@ -239,15 +434,17 @@ static Chromosome inheritEncodingForChild(
 
 static inline bool isDroneCustomerNode(const PDPData& data, int nodeId) {
     if (!data.isCustomer(nodeId)) return false;
-    if (nodeId < 0 || nodeId >= data.numNodes) return false;
-    return (data.nodeTypes[nodeId] == "D" && data.readyTimes[nodeId] > 0);
+    return data.isDroneEligible(nodeId);
 }
 
 // Randomly change truck assignment at a few positions.
 static void mutateTruckAssignment(Chromosome& c, mt19937& gen, const PDPData& data) {
     int n = (int)c.sequence.size();
     if (n == 0 || data.numTrucks <= 1) return;
-    if ((int)c.truck_assign.size() != n) c.truck_assign.assign(n, 0);
+    if ((int)c.truck_assign.size() != n) {
+        c.truck_assign.assign(n, 0);
+        c.invalidateFingerprint();
+    }
 
     // Mutate ~5% positions, at least 1.
     int k = max(1, n / 20);
@@ -259,7 +456,7 @@ static void mutateTruckAssignment(Chromosome& c, mt19937& gen, const PDPData& da
         int cur = c.truck_assign[i];
         int delta = 1 + deltaDist(gen);
         int next = (cur + delta) % data.numTrucks;
-        c.truck_assign[i] = next;
+        c.setGene(FIELD_TRUCK, i, next);
     }
 }
 
@@ -267,13 +464,16 @@ static void mutateTruckAssignment(Chromosome& c, mt19937& gen, const PDPData& da
 static void mutateDroneAssignment(Chromosome& c, mt19937& gen, const PDPData& data) {
     int n = (int)c.sequence.size();
     if (n == 0 || data.numDrones <= 0) return;
-    if ((int)c.drone_assign.size() != n) c.drone_assign.assign(n, 0);
+    if ((int)c.drone_assign.size() != n) {
+        c.drone_assign.assign(n, 0);
+        c.invalidateFingerprint();
+    }
 
     vector<int> dPositions;
     dPositions.reserve(n);
     for (int i = 0; i < n; ++i) {
         if (isDroneCustomerNode(data, c.sequence[i])) dPositions.push_back(i);
-        else c.drone_assign[i] = 0; // keep non-D consistent
+        else if (c.drone_assign[i] != 0) c.setGene(FIELD_DRONE, i, 0); // keep non-D consistent
     }
     if (dPositions.empty()) return;
 
@@ -292,7 +492,10 @@ static void mutateDroneAssignment(Chromosome& c, mt19937& gen, const PDPData& da
             next = droneDist(gen);
             if (next != cur) break;
         }
-        c.drone_assign[i] = next;
+        // Never hand the drone a trip it cannot reach the truck for
+        if (startsUnreachableDroneTrip(c.sequence, c.truck_assign, c.drone_assign, c.break_bit, i, next, data))
+            next = 0;
+        c.setGene(FIELD_DRONE, i, next);
     }
 }
 
@@ -300,14 +503,17 @@ static void mutateDroneAssignment(Chromosome& c, mt19937& gen, const PDPData& da
 static void mutateBreakBit(Chromosome& c, mt19937& gen) {
     int n = (int)c.sequence.size();
     if (n == 0) return;
-    if ((int)c.break_bit.size() != n) c.break_bit.assign(n, 1);
+    if ((int)c.break_bit.size() != n) {
+        c.break_bit.assign(n, 1);
+        c.invalidateFingerprint();
+    }
 
     // Mutate ~10% positions, at least 1.
     int k = max(1, n / 10);
     uniform_int_distribution<> posDist(0, n - 1);
     for (int t = 0; t < k; ++t) {
         int i = posDist(gen);
-        c.break_bit[i] = (c.break_bit[i] == 0) ? 1 : 0;
+        c.setGene(FIELD_BREAK, i, (c.break_bit[i] == 0) ? 1 : 0);
     }
 }
 
@@ -316,9 +522,12 @@ static void mutateBreakBit(Chromosome& c, mt19937& gen) {
 static void mutateLongRangeConsolidation(Chromosome& c, mt19937& gen, const PDPData& data) {
     int n = (int)c.sequence.size();
     if (n < 2 || data.numDrones <= 0) return;
-    if ((int)c.drone_assign.size() != n) c.drone_assign.assign(n, 0);
-    if ((int)c.break_bit.size() != n) c.break_bit.assign(n, 1);
-    if ((int)c.truck_assign.size() != n) c.truck_assign.assign(n, 0);
+    if ((int)c.drone_assign.size() != n || (int)c.break_bit.size() != n || (int)c.truck_assign.size() != n) {
+        if ((int)c.drone_assign.size() != n) c.drone_assign.assign(n, 0);
+        if ((int)c.break_bit.size() != n) c.break_bit.assign(n, 1);
+        if ((int)c.truck_assign.size() != n) c.truck_assign.assign(n, 0);
+        c.invalidateFingerprint();
+    }
 
     // Collect candidates i that are D-type and currently assigned to some drone k>0.
     vector<int> candidatesI;
@@ -371,20 +580,23 @@ static void mutateLongRangeConsolidation(Chromosome& c, mt19937& gen, const PDPD
     int droneVal = c.drone_assign[j];
     int breakVal = c.break_bit[j];
 
+    // If we remove an element before i, i shifts left by 1.
+    int insertPos = min(n - 1, (j < i ? i - 1 : i) + 1);
+    // Only positions between j and insertPos change
+    int lo = min(j, insertPos), hi = max(j, insertPos);
+    c.toggleFingerprintRange(lo, hi);
+
     eraseAt(c.sequence, j);
     eraseAt(c.truck_assign, j);
     eraseAt(c.drone_assign, j);
     eraseAt(c.break_bit, j);
 
-    // If we removed an element before i, i shifts left by 1.
-    if (j < i) i -= 1;
-
-    int insertPos = min(n - 1, i + 1);
     insertAt(c.sequence, insertPos, seqVal);
     insertAt(c.truck_assign, insertPos, truckVal);
     insertAt(c.drone_assign, insertPos, droneVal);
     // Force merge: set break_bit of the moved (second) customer to 0.
     insertAt(c.break_bit, insertPos, 0);
+    c.toggleFingerprintRange(lo, hi);
 
     (void)breakVal; // old break bit intentionally ignored
 }
@@ -394,10 +606,15 @@ static void swapMutationChromosome(Chromosome& c, mt19937& gen) {
     uniform_int_distribution<> dist(0, (int)c.sequence.size() - 1);
     int i = dist(gen);
     int j = dist(gen);
+    if (i == j) return;
+    c.toggleFingerprintRange(i, i);
+    c.toggleFingerprintRange(j, j);
     swap(c.sequence[i], c.sequence[j]);
     if (c.truck_assign.size() == c.sequence.size()) swap(c.truck_assign[i], c.truck_assign[j]);
     if (c.drone_assign.size() == c.sequence.size()) swap(c.drone_assign[i], c.drone_assign[j]);
     if (c.break_bit.size() == c.sequence.size()) swap(c.break_bit[i], c.break_bit[j]);
+    c.toggleFingerprintRange(i, i);
+    c.toggleFingerprintRange(j, j);
 }
 
 static void inversionMutationChromosome(Chromosome& c, mt19937& gen) {
@@ -406,10 +623,12 @@ static void inversionMutationChromosome(Chromosome& c, mt19937& gen) {
     int i = dist(gen);
     int j = dist(gen);
     if (i > j) swap(i, j);
+    c.toggleFingerprintRange(i, j);
     reverse(c.sequence.begin() + i, c.sequence.begin() + j + 1);
     if (c.truck_assign.size() == c.sequence.size()) reverse(c.truck_assign.begin() + i, c.truck_assign.begin() + j + 1);
     if (c.drone_assign.size() == c.sequence.size()) reverse(c.drone_assign.begin() + i, c.drone_assign.begin() + j + 1);
     if (c.break_bit.size() == c.sequence.size()) reverse(c.break_bit.begin() + i, c.break_bit.begin() + j + 1);
+    c.toggleFingerprintRange(i, j);
 }
 
 static void scrambleMutationChromosome(Chromosome& c, mt19937& gen) {
@@ -430,6 +649,7 @@ static void scrambleMutationChromosome(Chromosome& c, mt19937& gen) {
         for (int t = 0; t < (int)idx.size(); ++t) v[i + t] = tmp[t];
     };
 
+    c.toggleFingerprintRange(i, j);
     {
         vector<int> tmp;
         tmp.reserve(idx.size());
@@ -439,6 +659,7 @@ static void scrambleMutationChromosome(Chromosome& c, mt19937& gen) {
     if (c.truck_assign.size() == c.sequence.size()) apply(c.truck_assign);
     if (c.drone_assign.size() == c.sequence.size()) apply(c.drone_assign);
     if (c.break_bit.size() == c.sequence.size()) apply(c.break_bit);
+    c.toggleFingerprintRange(i, j);
 }
 
 static void insertionMutationChromosome(Chromosome& c, mt19937& gen) {
@@ -458,10 +679,13 @@ static void insertionMutationChromosome(Chromosome& c, mt19937& gen) {
         v[toPos] = element;
     };
 
+    int lo = min(fromPos, toPos), hi = max(fromPos, toPos);
+    c.toggleFingerprintRange(lo, hi);
     moveOne(c.sequence);
     if (c.truck_assign.size() == c.sequence.size()) moveOne(c.truck_assign);
     if (c.drone_assign.size() == c.sequence.size()) moveOne(c.drone_assign);
     if (c.break_bit.size() == c.sequence.size()) moveOne(c.break_bit);
+    c.toggleFingerprintRange(lo, hi);
 }
 
 static void displacementMutationChromosome(Chromosome& c, mt19937& gen) {
@@ -495,10 +719,16 @@ static void displacementMutationChromosome(Chromosome& c, mt19937& gen) {
         v.insert(v.begin() + insertPos, segment.begin(), segment.end());
     };
 
+    // Only positions between the old and new segment placement change
+    int finalPos = newPos > start ? newPos - segLen : newPos;
+    finalPos = max(0, min(finalPos, (int)c.sequence.size() - segLen));
+    int lo = min(start, finalPos), hi = max(end, finalPos + segLen - 1);
+    c.toggleFingerprintRange(lo, hi);
     moveSeg(c.sequence);
     if (c.truck_assign.size() == c.sequence.size()) moveSeg(c.truck_assign);
     if (c.drone_assign.size() == c.sequence.size()) moveSeg(c.drone_assign);
     if (c.break_bit.size() == c.sequence.size()) moveSeg(c.break_bit);
+    c.toggleFingerprintRange(lo, hi);
 }
 
 // ============ PERTURBATION OPERATORS (for Tabu diversification) ============
@@ -1028,491 +1258,891 @@ bool evaluateMutationImprovement(const vector<int>& mutated, const vector<int>&
     (void)data;
     return mutated != original;
 }
-
 // ============ MAIN GA ALGORITHM ============
 
-PDPSolution geneticAlgorithmPDP(const PDPData& data, int populationSize, 
-                               int maxGenerations, double mutationRate, int runNumber) {
-    random_device rd;
-    mt19937 rng(rd() + runNumber * 12345);
-    
-    cout << "\n=========================================" << endl;
-    cout << "  GENETIC ALGORITHM + TABU SEARCH (PDP)" << endl;
-    cout << "=========================================" << endl;
-    cout << "Population size: " << populationSize << endl;
-    cout << "Max generations: " << maxGenerations << endl;
-    cout << "Base mutation rate: " << mutationRate << " (adaptive)" << endl;
-    cout << "Tabu threshold: decoded-evaluation based" << endl;
-    cout << "Adaptive operators: ENABLED" << endl;
-    
-    // Initialize adaptive parameters
-    AdaptiveParams adaptiveParams(mutationRate);
-    OnlineSurrogate surrogate;
-    
-    // STEP 0: Initialize Solution Cache
-    // Cache persists across all generations to leverage solution reuse
-    SolutionCache solutionCache;
-    cout << "\n[0] Solution Cache initialized (MAX_SIZE: 150000 entries ≈ 1.5GB RAM)" << endl;
-    
-    // STEP 1: Initialize population
-    cout << "\n[1] Initializing population..." << endl;
+// Evolving state of one population. The classic GA is a single island; in island
+// mode every island evolves on its own thread with its own RNG, adaptive operator
+// rates and surrogate, and only SolutionCache is shared.
+struct GAIsland {
+    int id = 0;
+    int runSeed = 0;                 // Seed for structured (re)initialization
+    mt19937 rng;
+    AdaptiveParams adaptiveParams;
+    SurrogateModel surrogate;
+
     vector<Chromosome> population;
+    vector<double> fitness;
+
+    PDPSolution bestSolution;
+    vector<int> bestSequence;
+    Chromosome bestChromosome;
+
+    int noImprovementCounter = 0;
+    int noImprovementEvalCounter = 0;
+    int tabuRounds = 0;
+    bool tabuApplied = false;
+
+    ostream* log = &cout;            // Per-island buffer in island mode
+    ThreadPool* evalPool = nullptr;  // Batch evaluation pool (nullptr = serial)
+
+    explicit GAIsland(double mutationRate) : adaptiveParams(mutationRate) {}
+
+    double bestFitness() const { return bestSolution.totalCost + bestSolution.totalPenalty; }
+};
+
+// Read-only settings shared by all islands
+struct GAContext {
+    const PDPData& data;
+    SolutionCache& solutionCache;
+    int populationSize;
+    int tabuThreshold;
+    int adaptationInterval;
+    int tabuLSStarts;      // Random assignment LS starts per tabu result
+    Deadline deadline;     // End of the GA + tabu phase (--time-limit)
+    const SolverConfig& config;
+};
+
+static void evaluateBatch(ThreadPool* pool, size_t count, const function<void(size_t)>& body) {
+    if (pool) {
+        pool->parallelFor(count, body);
+    } else {
+        for (size_t i = 0; i < count; ++i) body(i);
+    }
+}
+
+// Random assignment encoding for seq: a multi-start LS starting point
+static AssignmentEncoding randomAssignment(const vector<int>& seq, const PDPData& data, mt19937& rng) {
+    AssignmentEncoding enc;
+    int seqLen = (int)seq.size();
+    enc.truck_assign.resize(seqLen);
+    enc.drone_assign.resize(seqLen);
+    enc.break_bit.resize(seqLen);
+
+    uniform_int_distribution<> truckDist(0, data.numTrucks - 1);
+    uniform_int_distribution<> droneDist(0, data.numDrones);
+    uniform_int_distribution<> bitDist(0, 1);
+
+    for (int j = 0; j < seqLen; j++) {
+        enc.truck_assign[j] = truckDist(rng);
+        int c = seq[j];
+        if (data.isCustomer(c) && data.isDroneEligible(c)) {
+            enc.drone_assign[j] = droneDist(rng);
+        } else {
+            enc.drone_assign[j] = 0;
+        }
+        enc.break_bit[j] = bitDist(rng);
+        if (startsUnreachableDroneTrip(seq, enc.truck_assign, enc.drone_assign, enc.break_bit, j,
+                                       enc.drone_assign[j], data))
+            enc.drone_assign[j] = 0;
+    }
+    return enc;
+}
+
+// Assignment LS from `starts` random encodings of seq; results in start order. Each
+// start draws from its own RNG stream, seeded from rng up front, so the results do not
+// depend on the thread count. With enough starts to occupy the pool they run
+// concurrently; otherwise one after another, each scanning its neighborhood in parallel.
+// Starts not yet begun when deadline expires are dropped from the results.
+static vector<PDPSolution> multiStartAssignmentLS(const vector<int>& seq, const PDPData& data,
+                                                  int starts, int maxIterations, mt19937& rng,
+                                                  ThreadPool* pool, const Deadline& deadline = Deadline()) {
+    vector<uint32_t> seeds(max(0, starts));
+    for (uint32_t& seed : seeds) seed = rng();
+
+    vector<PDPSolution> results(seeds.size());
+    vector<char> ran(seeds.size(), 0);
+    auto runStart = [&](size_t k, ThreadPool* scanPool) {
+        if (deadline.expired()) return;
+        mt19937 startRng(seeds[k]);
+        AssignmentEncoding enc = randomAssignment(seq, data, startRng);
+        results[k] = runAssignmentLS(seq, enc, data, maxIterations, scanPool, deadline);
+        ran[k] = 1;
+    };
+    if (pool && (int)seeds.size() >= pool->size()) {
+        pool->parallelFor(seeds.size(), [&](size_t k) { runStart(k, nullptr); });
+    } else {
+        for (size_t k = 0; k < seeds.size(); k++) runStart(k, pool);
+    }
+
+    size_t kept = 0;
+    for (size_t k = 0; k < results.size(); k++) {
+        if (!ran[k]) continue;
+        if (kept != k) results[kept] = std::move(results[k]);
+        kept++;
+    }
+    results.resize(kept);
+    return results;
+}
+
+// STEP 1: structured initial population and its best individual
+static void initIsland(GAIsland& island, const GAContext& ctx) {
+    const PDPData& data = ctx.data;
+    SolutionCache& solutionCache = ctx.solutionCache;
+    int populationSize = ctx.populationSize;
+    ostream& log = *island.log;
+    vector<Chromosome>& population = island.population;
+    vector<double>& fitness = island.fitness;
+
     population.resize(populationSize);
     {
-        vector<Chromosome> initChromos = initStructuredPopulationChromosome(populationSize, data, runNumber);
+        vector<Chromosome> initChromos = initStructuredPopulationChromosome(populationSize, data, island.runSeed,
+                                                                             ctx.config.seed, log);
         for (int i = 0; i < populationSize; ++i) {
             population[i] = (i < (int)initChromos.size()) ? initChromos[i] : Chromosome();
         }
     }
-    
+
     // Evaluate initial population
-    vector<double> fitness(populationSize);
-    PDPSolution bestSolution;
-    bestSolution.totalCost = numeric_limits<double>::infinity();
-    vector<int> bestSequence;
-    Chromosome bestChromosome;
-    
+    fitness.assign(populationSize, 0.0);
+    island.bestSolution = PDPSolution();
+    island.bestSolution.totalCost = numeric_limits<double>::infinity();
+
+    int initBestIdx = -1;
+    evaluateBatch(island.evalPool, populationSize, [&](size_t i) {
+        PDPCost cost = evaluateCostWithCache(population[i], data, solutionCache);
+        fitness[i] = cost.totalCost + cost.totalPenalty;
+    });
     for (int i = 0; i < populationSize; ++i) {
-        PDPSolution sol = evaluateWithCache(population[i], data, solutionCache);
-        fitness[i] = sol.totalCost + sol.totalPenalty;
+        if (initBestIdx < 0 || fitness[i] < fitness[initBestIdx]) initBestIdx = i;
+    }
+    // Full decode only for the best initial individual
+    if (initBestIdx >= 0 && fitness[initBestIdx] < island.bestFitness()) {
+        island.bestSolution = evaluateWithCache(population[initBestIdx], data, solutionCache);
+        island.bestSequence = island.bestSolution.sequence;
+        island.bestChromosome = static_cast<const Chromosome&>(island.bestSolution);
+    }
+
+    log << "Initial best cost: " << fixed << setprecision(2)
+        << island.bestSolution.totalCost << " (penalty: " << island.bestSolution.totalPenalty << ")" << endl;
+}
+
+// STEP 2: one generation (crossover, mutation, screening, selection, adaptation, tabu)
+static void evolveGeneration(GAIsland& island, const GAContext& ctx, int generation) {
+    const PDPData& data = ctx.data;
+    SolutionCache& solutionCache = ctx.solutionCache;
+    int populationSize = ctx.populationSize;
+    int tabuThreshold = ctx.tabuThreshold;
+    int adaptationInterval = ctx.adaptationInterval;
+    ostream& log = *island.log;
+
+    mt19937& rng = island.rng;
+    AdaptiveParams& adaptiveParams = island.adaptiveParams;
+    SurrogateModel& surrogate = island.surrogate;
+    vector<Chromosome>& population = island.population;
+    vector<double>& fitness = island.fitness;
+    PDPSolution& bestSolution = island.bestSolution;
+    vector<int>& bestSequence = island.bestSequence;
+    Chromosome& bestChromosome = island.bestChromosome;
+    int& noImprovementCounter = island.noImprovementCounter;
+    int& noImprovementEvalCounter = island.noImprovementEvalCounter;
+    int& tabuRounds = island.tabuRounds;
+    bool& tabuApplied = island.tabuApplied;
+
+    // 2.1: Create offspring using adaptive crossover
+    vector<Chromosome> offspring;
+    vector<int> crossoverTypes;
+    vector<pair<double, double>> parentFitnesses;  // Track parent fitness for threshold
+    
+    int numOffspring = populationSize;
+    for (int i = 0; i < numOffspring; ++i) {
+        int p1Idx = tournamentSelection(fitness, 3, rng);
+        int p2Idx = tournamentSelection(fitness, 3, rng);
+        const vector<int>& parent1 = population[p1Idx].sequence;
+        const vector<int>& parent2 = population[p2Idx].sequence;
+        parentFitnesses.push_back({fitness[p1Idx], fitness[p2Idx]});
         
-        if (fitness[i] < bestSolution.totalCost + bestSolution.totalPenalty) {
-            bestSolution = sol;
-            bestSequence = sol.sequence;
-            bestChromosome = static_cast<const Chromosome&>(sol);
+        int crossoverType = adaptiveParams.selectCrossoverType(rng);
+        crossoverTypes.push_back(crossoverType);
+        
+        vector<int> child;
+        // Use only first 3 crossovers (safer, well-tested)
+        int safeType = crossoverType % 3;
+        if (safeType == 0) {
+            child = orderCrossover(parent1, parent2, rng);
+        } else if (safeType == 1) {
+            child = pmxCrossover(parent1, parent2, rng);
+        } else {
+            child = cycleCrossover(parent1, parent2, rng);
         }
-    }
+        repairSequence(child, data, rng);
+
+        Chromosome childChromo = inheritEncodingForChild(child, population[p1Idx], population[p2Idx], data, rng);
+        // Hashed once here; mutations below update it incrementally
+        childChromo.refreshFingerprint();
+        offspring.push_back(childChromo);
+        
     
-    cout << "Initial best cost: " << fixed << setprecision(2) 
-         << bestSolution.totalCost << " (penalty: " << bestSolution.totalPenalty << ")" << endl;
+        bool improved = evaluateImprovement(child, parent1, parent2, data);
+        adaptiveParams.updateCrossoverSuccess(crossoverType, improved);
+    }
     
-    int noImprovementCounter = 0;
-    int noImprovementEvalCounter = 0;
-    int earlyStopThreshold = (int)(0.2 * maxGenerations);  // 20% of generations without improvement
-    int tabuThreshold = data.numCustomers <= 20 ? 
-                        max(100, populationSize * 5) :      // Small instances: trigger early Tabu
-                        max(200, populationSize * 20);      // Large instances: original threshold
-    int tabuRounds = 0;
-    bool tabuApplied = false;
-    int adaptationInterval = max(5, maxGenerations / 20);
+    // 2.2: Adaptive Mutation
+    int mutationCount = (int)(offspring.size() * adaptiveParams.currentMutationRate);
+    uniform_int_distribution<> offspringDist(0, offspring.size() - 1);
     
-    // STEP 2: GA Loop
-    for (int generation = 0; generation < maxGenerations; ++generation) {
-        // 2.1: Create offspring using adaptive crossover
-        vector<Chromosome> offspring;
-        vector<int> crossoverTypes;
-        vector<pair<double, double>> parentFitnesses;  // Track parent fitness for threshold
+    for (int i = 0; i < mutationCount; ++i) {
+        int idx = offspringDist(rng);
+        Chromosome original = offspring[idx];
         
-        int numOffspring = populationSize;
-        for (int i = 0; i < numOffspring; ++i) {
-            int p1Idx = tournamentSelection(fitness, 3, rng);
-            int p2Idx = tournamentSelection(fitness, 3, rng);
-            const vector<int>& parent1 = population[p1Idx].sequence;
-            const vector<int>& parent2 = population[p2Idx].sequence;
-            parentFitnesses.push_back({fitness[p1Idx], fitness[p2Idx]});
-            
-            int crossoverType = adaptiveParams.selectCrossoverType(rng);
-            crossoverTypes.push_back(crossoverType);
-            
-            vector<int> child;
-            // Use only first 3 crossovers (safer, well-tested)
-            int safeType = crossoverType % 3;
-            if (safeType == 0) {
-                child = orderCrossover(parent1, parent2, rng);
-            } else if (safeType == 1) {
-                child = pmxCrossover(parent1, parent2, rng);
-            } else {
-                child = cycleCrossover(parent1, parent2, rng);
-            }
-            repairSequence(child, data, rng);
-
-            Chromosome childChromo = inheritEncodingForChild(child, population[p1Idx], population[p2Idx], data, rng);
-            offspring.push_back(childChromo);
-            
-        
-            bool improved = evaluateImprovement(child, parent1, parent2, data);
-            adaptiveParams.updateCrossoverSuccess(crossoverType, improved);
+        // Mix structural mutations (sequence-level) AND property mutations (assignment-level).
+        // Structural mutations keep the "bốc nguyên cột dọc" behavior; property mutations break that stickiness.
+        int mutationType = adaptiveParams.selectMutationType(rng);
+        if (mutationType == 0) {
+            swapMutationChromosome(offspring[idx], rng);
+        } else if (mutationType == 1) {
+            inversionMutationChromosome(offspring[idx], rng);
+        } else if (mutationType == 2) {
+            scrambleMutationChromosome(offspring[idx], rng);
+        } else if (mutationType == 3) {
+            insertionMutationChromosome(offspring[idx], rng);
+        } else {
+            displacementMutationChromosome(offspring[idx], rng);
         }
-        
-        // 2.2: Adaptive Mutation
-        int mutationCount = (int)(offspring.size() * adaptiveParams.currentMutationRate);
-        uniform_int_distribution<> offspringDist(0, offspring.size() - 1);
-        
-        for (int i = 0; i < mutationCount; ++i) {
-            int idx = offspringDist(rng);
-            Chromosome original = offspring[idx];
-            
-            // Mix structural mutations (sequence-level) AND property mutations (assignment-level).
-            // Structural mutations keep the "bốc nguyên cột dọc" behavior; property mutations break that stickiness.
-            int mutationType = adaptiveParams.selectMutationType(rng);
-            if (mutationType == 0) {
-                swapMutationChromosome(offspring[idx], rng);
-            } else if (mutationType == 1) {
-                inversionMutationChromosome(offspring[idx], rng);
-            } else if (mutationType == 2) {
-                scrambleMutationChromosome(offspring[idx], rng);
-            } else if (mutationType == 3) {
-                insertionMutationChromosome(offspring[idx], rng);
-            } else {
-                displacementMutationChromosome(offspring[idx], rng);
-            }
 
-            // Property mutation stage (probabilistic): encourages assignment exploration.
-            // Tune these if you see either too much randomness (penalties explode) or too much convergence.
-            bernoulli_distribution doProp(0.55);
-            if (doProp(rng)) {
-                // Weighted choice among 4 property mutations.
-                // (truck, drone, break, long-range)
-                discrete_distribution<> propPick({25, 30, 30, 15});
-                int p = propPick(rng);
-                if (p == 0) {
-                    mutateTruckAssignment(offspring[idx], rng, data);
-                } else if (p == 1) {
-                    mutateDroneAssignment(offspring[idx], rng, data);
-                } else if (p == 2) {
-                    mutateBreakBit(offspring[idx], rng);
-                } else {
-                    mutateLongRangeConsolidation(offspring[idx], rng, data);
-                }
+        // Property mutation stage (probabilistic): encourages assignment exploration.
+        // Tune these if you see either too much randomness (penalties explode) or too much convergence.
+        bernoulli_distribution doProp(0.55);
+        if (doProp(rng)) {
+            // Weighted choice among 4 property mutations.
+            // (truck, drone, break, long-range)
+            discrete_distribution<> propPick({25, 30, 30, 15});
+            int p = propPick(rng);
+            if (p == 0) {
+                mutateTruckAssignment(offspring[idx], rng, data);
+            } else if (p == 1) {
+                mutateDroneAssignment(offspring[idx], rng, data);
+            } else if (p == 2) {
+                mutateBreakBit(offspring[idx], rng);
+            } else {
+                mutateLongRangeConsolidation(offspring[idx], rng, data);
             }
-
-            // Lightweight proxy: mutation is useful if anything changed.
-            bool improved = !(offspring[idx] == original);
-            adaptiveParams.updateMutationSuccess(mutationType, improved);
         }
-        
-        // 2.3: Evaluate offspring with quota-based pre-screening (elite + exploration)
-        // Compute adaptive φ = η_current / η_max (η_max = 100)
-        double phi = min(1.0, (double)noImprovementCounter / 100.0);
-        
-        // Get current best cost and compute threshold
-        double currentBestCost = bestSolution.totalCost + bestSolution.totalPenalty;
-        
-        // Threshold = (1 - φ) * z(χ*) + φ * LB(χ*)
-        // Where z(χ*) = best solution cost, LB(χ*) = lower bound estimate
-        vector<double> offspringFitness(offspring.size(), numeric_limits<double>::infinity());
-        int decodedCount = 0;
-        int skippedCount = 0;
-        vector<double> proxyScore(offspring.size(), currentBestCost);
-        vector<int> proxyOrder(offspring.size(), 0);
-        iota(proxyOrder.begin(), proxyOrder.end(), 0);
-
-        // Build cheap proxy score (lower is better).
-        for (size_t i = 0; i < offspring.size(); ++i) {
-            double lowerBoundEstimate = currentBestCost;
-            if (i < parentFitnesses.size()) {
-                lowerBoundEstimate = min(parentFitnesses[i].first, parentFitnesses[i].second) * 0.98;
-            }
-            // Adaptive threshold still used as a smooth proxy anchor.
-            double threshold = (1.0 - phi) * currentBestCost + phi * lowerBoundEstimate;
-            proxyScore[i] = min(lowerBoundEstimate, threshold);
+
+        // Lightweight proxy: mutation is useful if anything changed.
+        bool improved = !(offspring[idx] == original);
+        adaptiveParams.updateMutationSuccess(mutationType, improved);
+    }
+    
+    // 2.3: Evaluate offspring with quota-based pre-screening (elite + exploration)
+    // Compute adaptive φ = η_current / η_max (η_max = 100)
+    double phi = min(1.0, (double)noImprovementCounter / 100.0);
+    
+    // Get current best cost and compute threshold
+    double currentBestCost = bestSolution.totalCost + bestSolution.totalPenalty;
+    
+    // Threshold = (1 - φ) * z(χ*) + φ * LB(χ*)
+    // Where z(χ*) = best solution cost, LB(χ*) = lower bound estimate
+    vector<double> offspringFitness(offspring.size(), numeric_limits<double>::infinity());
+    int decodedCount = 0;
+    int skippedCount = 0;
+    vector<double> proxyScore(offspring.size(), currentBestCost);
+    vector<int> proxyOrder(offspring.size(), 0);
+    iota(proxyOrder.begin(), proxyOrder.end(), 0);
+
+    // Build cheap proxy score (lower is better), never below the child's own lower bound.
+    vector<double> lowerBound(offspring.size());
+    for (size_t i = 0; i < offspring.size(); ++i) {
+        lowerBound[i] = costLowerBound(offspring[i], data);
+        double lowerBoundEstimate = currentBestCost;
+        if (i < parentFitnesses.size()) {
+            lowerBoundEstimate = min(parentFitnesses[i].first, parentFitnesses[i].second) * 0.98;
         }
+        // Adaptive threshold still used as a smooth proxy anchor.
+        double threshold = (1.0 - phi) * currentBestCost + phi * lowerBoundEstimate;
+        proxyScore[i] = max(min(lowerBoundEstimate, threshold), lowerBound[i]);
+    }
 
-        sort(proxyOrder.begin(), proxyOrder.end(),
-             [&proxyScore](int a, int b) { return proxyScore[a] < proxyScore[b]; });
+    // Surrogate features; the elites are the best sequence and the 4 best parents
+    EliteEdges eliteEdges;
+    {
+        vector<int> byFitness(population.size());
+        iota(byFitness.begin(), byFitness.end(), 0);
+        int numElites = min(4, (int)byFitness.size());
+        partial_sort(byFitness.begin(), byFitness.begin() + numElites, byFitness.end(),
+                     [&](int a, int b) { return fitness[a] < fitness[b]; });
+        vector<const vector<int>*> elites;
+        if (!bestSequence.empty()) elites.push_back(&bestSequence);
+        for (int k = 0; k < numElites; ++k) elites.push_back(&population[byFitness[k]].sequence);
+        eliteEdges.build(elites, data.numNodes);
+    }
+    vector<array<double, SF_COUNT>> features(offspring.size());
+    vector<double> predicted(offspring.size());
+    for (size_t i = 0; i < offspring.size(); ++i) {
+        double parentFitness = i < parentFitnesses.size()
+            ? min(parentFitnesses[i].first, parentFitnesses[i].second) : currentBestCost;
+        surrogateFeatures(offspring[i], parentFitness, lowerBound[i], eliteEdges, data, features[i].data());
+        predicted[i] = surrogate.predict(features[i].data(), proxyScore[i]);
+    }
 
-        int eliteDecodeCount = max(1, (int)(offspring.size() * 0.50));
-        int exploreDecodeCount = max(1, (int)(offspring.size() * 0.10));
-        vector<char> shouldDecode(offspring.size(), 0);
+    // Rank by the surrogate once it is fitted, by the parent proxy before that
+    bool useSurrogate = surrogate.ready();
+    const vector<double>& rankScore = useSurrogate ? predicted : proxyScore;
+    sort(proxyOrder.begin(), proxyOrder.end(),
+         [&rankScore](int a, int b) { return rankScore[a] < rankScore[b]; });
+
+    // Decode the best-ranked eliteDecodeShare (50%), down to 60% of it (30%) as the
+    // measured rank correlation of the surrogate goes from 0.5 to 1
+    double eliteShare = ctx.config.eliteDecodeShare;
+    if (useSurrogate && surrogate.rankCorrelation > 0.5) {
+        eliteShare *= 1.0 - 0.80 * (surrogate.rankCorrelation - 0.5);
+    }
+    int eliteDecodeCount = max(1, (int)(offspring.size() * eliteShare));
+    int exploreDecodeCount = max(1, (int)(offspring.size() * ctx.config.exploreDecodeShare));
+    vector<char> shouldDecode(offspring.size(), 0);
 
-        for (int k = 0; k < eliteDecodeCount && k < (int)proxyOrder.size(); ++k) {
-            shouldDecode[proxyOrder[k]] = 1;
-        }
+    for (int k = 0; k < eliteDecodeCount && k < (int)proxyOrder.size(); ++k) {
+        shouldDecode[proxyOrder[k]] = 1;
+    }
 
-        vector<int> tailIdx;
-        for (int k = eliteDecodeCount; k < (int)proxyOrder.size(); ++k) {
-            tailIdx.push_back(proxyOrder[k]);
-        }
+    vector<int> tailIdx;
+    for (int k = eliteDecodeCount; k < (int)proxyOrder.size(); ++k) {
+        tailIdx.push_back(proxyOrder[k]);
+    }
 
-        // Diversity-aware exploration: decode candidates that are most novel vs current best.
-        vector<pair<double, int>> noveltyCandidates;
-        noveltyCandidates.reserve(tailIdx.size());
-        for (int idx : tailIdx) {
-            double novelty = edgeNoveltyScore(offspring[idx].sequence, bestSequence);
-            noveltyCandidates.push_back({novelty, idx});
-        }
-        sort(noveltyCandidates.begin(), noveltyCandidates.end(),
-             [](const pair<double, int>& a, const pair<double, int>& b) {
-                 return a.first > b.first;
-             });
-        for (int k = 0; k < exploreDecodeCount && k < (int)noveltyCandidates.size(); ++k) {
-            shouldDecode[noveltyCandidates[k].second] = 1;
-        }
-        
-        for (size_t i = 0; i < offspring.size(); ++i) {
-            if (shouldDecode[i]) {
-                PDPSolution sol = evaluateWithCache(offspring[i], data, solutionCache);
-                offspringFitness[i] = sol.totalCost + sol.totalPenalty;
-                surrogate.update(proxyScore[i], offspringFitness[i]);
-                decodedCount++;
-            } else {
-                // Surrogate-assisted estimate for non-decoded offspring.
-                double predicted = surrogate.predict(proxyScore[i], proxyScore[i]);
-                double conservative = max(proxyScore[i], predicted);
-                offspringFitness[i] = conservative * 1.02;
-                skippedCount++;
+    // Diversity-aware exploration: decode candidates that are most novel vs current best.
+    vector<pair<double, int>> noveltyCandidates;
+    noveltyCandidates.reserve(tailIdx.size());
+    for (int idx : tailIdx) {
+        double novelty = edgeNoveltyScore(offspring[idx].sequence, bestSequence);
+        noveltyCandidates.push_back({novelty, idx});
+    }
+    sort(noveltyCandidates.begin(), noveltyCandidates.end(),
+         [](const pair<double, int>& a, const pair<double, int>& b) {
+             return a.first > b.first;
+         });
+    for (int k = 0; k < exploreDecodeCount && k < (int)noveltyCandidates.size(); ++k) {
+        shouldDecode[noveltyCandidates[k].second] = 1;
+    }
+    
+    // Decode the selected offspring as one parallel batch. The surrogate is
+    // order-dependent, so it is fed afterwards in index order as before.
+    vector<int> decodeIdx;
+    for (size_t i = 0; i < offspring.size(); ++i) {
+        if (shouldDecode[i]) decodeIdx.push_back((int)i);
+    }
+    evaluateBatch(island.evalPool, decodeIdx.size(), [&](size_t k) {
+        int i = decodeIdx[k];
+        PDPCost sol = evaluateCostWithCache(offspring[i], data, solutionCache);
+        offspringFitness[i] = sol.totalCost + sol.totalPenalty;
+    });
+
+    vector<double> decodedPredicted, decodedActual;
+    for (size_t i = 0; i < offspring.size(); ++i) {
+        if (shouldDecode[i]) {
+            if (useSurrogate) {
+                decodedPredicted.push_back(predicted[i]);
+                decodedActual.push_back(offspringFitness[i]);
             }
+            surrogate.update(features[i].data(), offspringFitness[i]);
+            decodedCount++;
+        } else {
+            // Surrogate-assisted estimate for non-decoded offspring.
+            double conservative = max(proxyScore[i], predicted[i]);
+            offspringFitness[i] = max(conservative, surrogate.meanFitness()) * 1.02;
+            skippedCount++;
         }
-        
-        if (generation > 0 && generation % 20 == 0) {
-            cout << "[THRESHOLD] Gen " << generation << ": φ=" << fixed << setprecision(3) << phi 
-                 << ", Best=" << setprecision(2) << currentBestCost
-                 << ", Decoded=" << decodedCount << "/" << offspring.size() 
-                 << " (" << (int)(decodedCount*100.0/offspring.size()) << "%)"
-                  << ", Skipped=" << skippedCount
-                  << ", SurrogateSamples=" << surrogate.n << endl;
+    }
+    if (useSurrogate) {
+        surrogate.recordRankCorrelation(spearmanRankCorrelation(decodedPredicted, decodedActual));
+    }
+    surrogate.fit();
+    
+    if (generation > 0 && generation % 20 == 0) {
+        log << "[THRESHOLD] Gen " << generation << ": φ=" << fixed << setprecision(3) << phi 
+             << ", Best=" << setprecision(2) << currentBestCost
+             << ", Decoded=" << decodedCount << "/" << offspring.size() 
+             << " (" << (int)(decodedCount*100.0/offspring.size()) << "%)"
+              << ", Skipped=" << skippedCount
+              << ", SurrogateSamples=" << surrogate.n
+              << ", RankCorr=" << setprecision(3) << surrogate.rankCorrelation << endl;
+    }
+    
+    // 2.4: Selection - 50% best offspring + 20% random offspring + 30% best parents
+    int numBestOffspring = (int)(populationSize * 0.5);
+    int numRandomOffspring = (int)(populationSize * 0.2);
+    int numBestParents = populationSize - numBestOffspring - numRandomOffspring;
+    
+    // Sort offspring
+    vector<int> offspringIndices(offspring.size());
+    iota(offspringIndices.begin(), offspringIndices.end(), 0);
+    sort(offspringIndices.begin(), offspringIndices.end(),
+         [&](int a, int b) { return offspringFitness[a] < offspringFitness[b]; });
+    
+    // Sort parents
+    vector<int> parentIndices(population.size());
+    iota(parentIndices.begin(), parentIndices.end(), 0);
+    sort(parentIndices.begin(), parentIndices.end(),
+         [&](int a, int b) { return fitness[a] < fitness[b]; });
+    
+    // Create new population
+    vector<Chromosome> newPopulation;
+    vector<double> newFitness;
+    
+    // 50% best offspring
+    for (int i = 0; i < numBestOffspring; ++i) {
+        newPopulation.push_back(offspring[offspringIndices[i]]);
+        newFitness.push_back(offspringFitness[offspringIndices[i]]);
+    }
+    
+    // 20% random offspring (from remaining, not already selected)
+    {
+        vector<int> remainingOffIdx;
+        for (int i = numBestOffspring; i < (int)offspringIndices.size(); ++i) {
+            remainingOffIdx.push_back(offspringIndices[i]);
         }
-        
-        // 2.4: Selection - 50% best offspring + 20% random offspring + 30% best parents
-        int numBestOffspring = (int)(populationSize * 0.5);
-        int numRandomOffspring = (int)(populationSize * 0.2);
-        int numBestParents = populationSize - numBestOffspring - numRandomOffspring;
-        
-        // Sort offspring
-        vector<int> offspringIndices(offspring.size());
-        iota(offspringIndices.begin(), offspringIndices.end(), 0);
-        sort(offspringIndices.begin(), offspringIndices.end(),
-             [&](int a, int b) { return offspringFitness[a] < offspringFitness[b]; });
-        
-        // Sort parents
-        vector<int> parentIndices(population.size());
-        iota(parentIndices.begin(), parentIndices.end(), 0);
-        sort(parentIndices.begin(), parentIndices.end(),
-             [&](int a, int b) { return fitness[a] < fitness[b]; });
-        
-        // Create new population
-        vector<Chromosome> newPopulation;
-        vector<double> newFitness;
-        
-        // 50% best offspring
-        for (int i = 0; i < numBestOffspring; ++i) {
-            newPopulation.push_back(offspring[offspringIndices[i]]);
-            newFitness.push_back(offspringFitness[offspringIndices[i]]);
+        shuffle(remainingOffIdx.begin(), remainingOffIdx.end(), rng);
+        int toAdd = min(numRandomOffspring, (int)remainingOffIdx.size());
+        for (int i = 0; i < toAdd; ++i) {
+            newPopulation.push_back(offspring[remainingOffIdx[i]]);
+            newFitness.push_back(offspringFitness[remainingOffIdx[i]]);
         }
+    }
+    
+    // 30% best parents (elitism)
+    for (int i = 0; i < numBestParents; ++i) {
+        newPopulation.push_back(population[parentIndices[i]]);
+        newFitness.push_back(fitness[parentIndices[i]]);
+    }
+    
+    population = newPopulation;
+    fitness = newFitness;
+    
+    // Update best solution
+    double currentBestCostAfterSelection = bestSolution.totalCost + bestSolution.totalPenalty;
+    int bestIdx = 0;
+    for (int i = 1; i < (int)fitness.size(); ++i) {
+        if (fitness[i] < fitness[bestIdx]) bestIdx = i;
+    }
+    if (fitness[bestIdx] < currentBestCostAfterSelection) {
+        PDPSolution sol = evaluateWithCache(population[bestIdx], data, solutionCache);
+        bestSolution = sol;
+        bestSequence = sol.sequence;
+        bestChromosome = static_cast<const Chromosome&>(sol);
+        noImprovementCounter = 0;
+        noImprovementEvalCounter = 0;
+        adaptiveParams.noImprovementCount = 0;
+
+        log << "Gen " << generation << ": New best = " << fixed << setprecision(2)
+             << bestSolution.totalCost << " (penalty: " << bestSolution.totalPenalty
+             << ", mut_rate: " << setprecision(3) << adaptiveParams.currentMutationRate << ")" << endl;
+    } else {
+        noImprovementCounter++;
+        noImprovementEvalCounter += decodedCount;
+        adaptiveParams.noImprovementCount++;
+    }
+    
+    // 2.6: Adaptive parameter updates
+    if (generation > 0 && generation % adaptationInterval == 0) {
+        adaptiveParams.adaptCrossoverRates();
+        adaptiveParams.adaptMutationRates();
+        adaptiveParams.adaptMutationRate();
         
-        // 20% random offspring (from remaining, not already selected)
-        {
-            vector<int> remainingOffIdx;
-            for (int i = numBestOffspring; i < (int)offspringIndices.size(); ++i) {
-                remainingOffIdx.push_back(offspringIndices[i]);
-            }
-            shuffle(remainingOffIdx.begin(), remainingOffIdx.end(), rng);
-            int toAdd = min(numRandomOffspring, (int)remainingOffIdx.size());
-            for (int i = 0; i < toAdd; ++i) {
-                newPopulation.push_back(offspring[remainingOffIdx[i]]);
-                newFitness.push_back(offspringFitness[remainingOffIdx[i]]);
+        // In thß╗æng k├¬ adaptive (mß╗ùi 10 generations)
+        if (generation % (adaptationInterval * 2) == 0) {
+            log << "[ADAPT] Gen " << generation << " - Crossover rates: ";
+            for (int i = 0; i < 4; ++i) {
+                log << fixed << setprecision(2) << adaptiveParams.crossoverRates[i] << " ";
             }
+            log << ", Mutation rate: " << setprecision(3) << adaptiveParams.currentMutationRate << endl;
         }
+    }
+    
+    // 2.5: Apply Tabu Search to top 5% after stagnation
+    if (noImprovementEvalCounter >= tabuThreshold) {
+        int topK = max(1, populationSize / 10); // top 10%
+        log << "\n[TABU] No improvement for " << noImprovementEvalCounter
+             << " decoded evaluations. Applying Tabu Search to top " << topK << " individuals..." << endl;
         
-        // 30% best parents (elitism)
-        for (int i = 0; i < numBestParents; ++i) {
-            newPopulation.push_back(population[parentIndices[i]]);
-            newFitness.push_back(fitness[parentIndices[i]]);
-        }
+        // Sort population indices by fitness (ascending = best first)
+        vector<int> sortedIdx(populationSize);
+        iota(sortedIdx.begin(), sortedIdx.end(), 0);
+        sort(sortedIdx.begin(), sortedIdx.end(), 
+             [&fitness](int a, int b) { return fitness[a] < fitness[b]; });
         
-        population = newPopulation;
-        fitness = newFitness;
+        double bestBeforeTabu = bestSolution.totalCost + bestSolution.totalPenalty;
         
-        // Update best solution
-        double currentBestCostAfterSelection = bestSolution.totalCost + bestSolution.totalPenalty;
-        int bestIdx = 0;
-        for (int i = 1; i < (int)fitness.size(); ++i) {
-            if (fitness[i] < fitness[bestIdx]) bestIdx = i;
-        }
-        if (fitness[bestIdx] < currentBestCostAfterSelection) {
-            PDPSolution sol = evaluateWithCache(population[bestIdx], data, solutionCache);
-            bestSolution = sol;
-            bestSequence = sol.sequence;
-            bestChromosome = static_cast<const Chromosome&>(sol);
-            noImprovementCounter = 0;
-            noImprovementEvalCounter = 0;
-            adaptiveParams.noImprovementCount = 0;
-
-            cout << "Gen " << generation << ": New best = " << fixed << setprecision(2)
-                 << bestSolution.totalCost << " (penalty: " << bestSolution.totalPenalty
-                 << ", mut_rate: " << setprecision(3) << adaptiveParams.currentMutationRate << ")" << endl;
-        } else {
-            noImprovementCounter++;
-            noImprovementEvalCounter += decodedCount;
-            adaptiveParams.noImprovementCount++;
+        // Also add random individuals (with perturbation) for diversity
+        int numRandom = topK; // same number of random individuals
+        vector<int> randomIdx;
+        {
+            vector<int> nonTopIdx;
+            for (int i = topK; i < populationSize; i++) nonTopIdx.push_back(sortedIdx[i]);
+            shuffle(nonTopIdx.begin(), nonTopIdx.end(), rng);
+            int toTake = min(numRandom, (int)nonTopIdx.size());
+            for (int i = 0; i < toTake; i++) randomIdx.push_back(nonTopIdx[i]);
         }
         
-        // 2.6: Adaptive parameter updates
-        if (generation > 0 && generation % adaptationInterval == 0) {
-            adaptiveParams.adaptCrossoverRates();
-            adaptiveParams.adaptMutationRates();
-            adaptiveParams.adaptMutationRate();
-            
-            // In thß╗æng k├¬ adaptive (mß╗ùi 10 generations)
-            if (generation % (adaptationInterval * 2) == 0) {
-                cout << "[ADAPT] Gen " << generation << " - Crossover rates: ";
-                for (int i = 0; i < 4; ++i) {
-                    cout << fixed << setprecision(2) << adaptiveParams.crossoverRates[i] << " ";
-                }
-                cout << ", Mutation rate: " << setprecision(3) << adaptiveParams.currentMutationRate << endl;
+        // Process top individuals + random individuals
+        int totalTabu = topK + (int)randomIdx.size();
+        for (int k = 0; k < totalTabu; ++k) {
+            int idx;
+            bool isRandom = (k >= topK);
+            if (!isRandom) {
+                idx = sortedIdx[k];
+            } else {
+                idx = randomIdx[k - topK];
             }
-        }
-        
-        // 2.5: Apply Tabu Search to top 5% after stagnation
-        if (noImprovementEvalCounter >= tabuThreshold) {
-            int topK = max(1, populationSize / 10); // top 10%
-            cout << "\n[TABU] No improvement for " << noImprovementEvalCounter
-                 << " decoded evaluations. Applying Tabu Search to top " << topK << " individuals..." << endl;
-            
-            // Sort population indices by fitness (ascending = best first)
-            vector<int> sortedIdx(populationSize);
-            iota(sortedIdx.begin(), sortedIdx.end(), 0);
-            sort(sortedIdx.begin(), sortedIdx.end(), 
-                 [&fitness](int a, int b) { return fitness[a] < fitness[b]; });
             
-            double bestBeforeTabu = bestSolution.totalCost + bestSolution.totalPenalty;
+            if ((int)population[idx].sequence.size() != data.numCustomers) continue;
+            if (ctx.deadline.expired()) break;
             
-            // Also add random individuals (with perturbation) for diversity
-            int numRandom = topK; // same number of random individuals
-            vector<int> randomIdx;
-            {
-                vector<int> nonTopIdx;
-                for (int i = topK; i < populationSize; i++) nonTopIdx.push_back(sortedIdx[i]);
-                shuffle(nonTopIdx.begin(), nonTopIdx.end(), rng);
-                int toTake = min(numRandom, (int)nonTopIdx.size());
-                for (int i = 0; i < toTake; i++) randomIdx.push_back(nonTopIdx[i]);
-            }
-            
-            // Process top individuals + random individuals
-            int totalTabu = topK + (int)randomIdx.size();
-            for (int k = 0; k < totalTabu; ++k) {
-                int idx;
-                bool isRandom = (k >= topK);
-                if (!isRandom) {
-                    idx = sortedIdx[k];
-                } else {
-                    idx = randomIdx[k - topK];
-                }
-                
-                if ((int)population[idx].sequence.size() != data.numCustomers) continue;
-                
-                try {
-                    // Apply perturbation before Tabu for diversity
-                    Chromosome startChromo = population[idx];
-                    if (isRandom || k > 0) {
-                        // Alternate between double-bridge and ruin-recreate
-                        if (k % 2 == 0) {
-                            startChromo = doubleBridgePerturbation(startChromo, rng);
-                        } else {
-                            startChromo = ruinRecreatePerturbation(startChromo, rng, 0.3);
-                        }
+            try {
+                // Apply perturbation before Tabu for diversity
+                Chromosome startChromo = population[idx];
+                if (isRandom || k > 0) {
+                    // Alternate between double-bridge and ruin-recreate
+                    if (k % 2 == 0) {
+                        startChromo = doubleBridgePerturbation(startChromo, rng);
+                    } else {
+                        startChromo = ruinRecreatePerturbation(startChromo, rng, 0.3);
                     }
+                }
 
-                    Chromosome tabuResult = tabuSearchPDP(startChromo, data, 50, solutionCache);
-                    if ((int)tabuResult.sequence.size() != data.numCustomers) continue;
+                Chromosome tabuResult = tabuSearchPDP(startChromo, data, ctx.config.tabuIterations, solutionCache,
+                                                      rng(), island.evalPool, ctx.deadline, log);
+                if ((int)tabuResult.sequence.size() != data.numCustomers) continue;
 
-                    // Multi-start Assignment LS: try 3 random starts, pick best
-                    PDPSolution bestTabuSol = evaluateWithCache(tabuResult, data, solutionCache);
-                    double bestTabuFit = bestTabuSol.totalCost + bestTabuSol.totalPenalty;
-                    
-                    for (int ms = 0; ms < 3; ms++) {
-                        // Create random assignment encoding
-                        AssignmentEncoding randEnc;
-                        int seqLen = (int)tabuResult.sequence.size();
-                        randEnc.truck_assign.resize(seqLen);
-                        randEnc.drone_assign.resize(seqLen);
-                        randEnc.break_bit.resize(seqLen);
-                        
-                        uniform_int_distribution<> truckDist(0, data.numTrucks - 1);
-                        uniform_int_distribution<> droneDist(0, data.numDrones);
-                        uniform_int_distribution<> bitDist(0, 1);
-                        
-                        for (int j = 0; j < seqLen; j++) {
-                            randEnc.truck_assign[j] = truckDist(rng);
-                            int c = tabuResult.sequence[j];
-                            if (data.isCustomer(c) && data.nodeTypes[c] == "D" && data.readyTimes[c] > 0) {
-                                randEnc.drone_assign[j] = droneDist(rng);
-                            } else {
-                                randEnc.drone_assign[j] = 0;
-                            }
-                            randEnc.break_bit[j] = bitDist(rng);
-                        }
-                        
-                        PDPSolution msSol = runAssignmentLS(tabuResult.sequence, randEnc, data, 50);
-                        double msFit = msSol.totalCost + msSol.totalPenalty;
-                        if (msFit < bestTabuFit - 0.01) {
-                            bestTabuSol = msSol;
-                            bestTabuFit = msFit;
-                        }
+                // Multi-start Assignment LS: random starts, pick best
+                PDPSolution bestTabuSol = evaluateWithCache(tabuResult, data, solutionCache);
+                double bestTabuFit = bestTabuSol.totalCost + bestTabuSol.totalPenalty;
+                
+                vector<PDPSolution> msSols = multiStartAssignmentLS(tabuResult.sequence, data, ctx.tabuLSStarts,
+                                                                    ctx.config.lsIterations, rng,
+                                                                    island.evalPool, ctx.deadline);
+                for (const PDPSolution& msSol : msSols) {
+                    double msFit = msSol.totalCost + msSol.totalPenalty;
+                    if (msFit < bestTabuFit - 0.01) {
+                        bestTabuSol = msSol;
+                        bestTabuFit = msFit;
                     }
+                }
+                
+                // Update population if improved
+                if (bestTabuFit < fitness[idx]) {
+                    population[idx] = static_cast<const Chromosome&>(bestTabuSol);
+                    fitness[idx] = bestTabuFit;
                     
-                    // Update population if improved
-                    if (bestTabuFit < fitness[idx]) {
-                        population[idx] = static_cast<const Chromosome&>(bestTabuSol);
-                        fitness[idx] = bestTabuFit;
-                        
-                        cout << "[TABU] Individual " << k << " (rank " << idx 
-                             << "): " << fixed << setprecision(2) << bestTabuFit << endl;
-                        
-                        // Update global best
-                        if (bestTabuFit < bestBeforeTabu) {
-                            bestSolution = bestTabuSol;
-                            bestSequence = bestTabuSol.sequence;
-                            bestChromosome = static_cast<const Chromosome&>(bestTabuSol);
-                            bestBeforeTabu = bestTabuFit;
-                        }
+                    log << "[TABU] Individual " << k << " (rank " << idx 
+                         << "): " << fixed << setprecision(2) << bestTabuFit << endl;
+                    
+                    // Update global best
+                    if (bestTabuFit < bestBeforeTabu) {
+                        bestSolution = bestTabuSol;
+                        bestSequence = bestTabuSol.sequence;
+                        bestChromosome = static_cast<const Chromosome&>(bestTabuSol);
+                        bestBeforeTabu = bestTabuFit;
                     }
-                } catch (const exception& e) {
-                    cerr << "ERROR in Tabu Search for individual " << k << ": " << e.what() << endl;
                 }
+            } catch (const exception& e) {
+                cerr << "ERROR in Tabu Search for individual " << k << ": " << e.what() << endl;
             }
+        }
+        
+        log << "[TABU] Best after Tabu+AssignLS: " << fixed << setprecision(2)
+             << bestSolution.totalCost << " (penalty: " << bestSolution.totalPenalty << ")" << endl;
+        
+        tabuApplied = true;
+        tabuRounds++;
+        noImprovementCounter = 0;
+        noImprovementEvalCounter = 0;
+        
+        // Diversity restart: if Tabu didn't improve after 3 rounds, regenerate 80%
+        if (tabuRounds >= 3 && bestSolution.totalCost + bestSolution.totalPenalty >= bestBeforeTabu - 0.01) {
+            log << "[DIVERSITY] Restarting 80% of population (keeping top 20%)..." << endl;
             
-            cout << "[TABU] Best after Tabu+AssignLS: " << fixed << setprecision(2)
-                 << bestSolution.totalCost << " (penalty: " << bestSolution.totalPenalty << ")" << endl;
+            // Re-sort after Tabu modifications
+            iota(sortedIdx.begin(), sortedIdx.end(), 0);
+            sort(sortedIdx.begin(), sortedIdx.end(), 
+                 [&fitness](int a, int b) { return fitness[a] < fitness[b]; });
             
-            tabuApplied = true;
-            tabuRounds++;
-            noImprovementCounter = 0;
-            noImprovementEvalCounter = 0;
+            // Keep top 20%, regenerate 80%
+            int keepCount = max(2, populationSize / 5);
             
-            // Diversity restart: if Tabu didn't improve after 3 rounds, regenerate 80%
-            if (tabuRounds >= 3 && bestSolution.totalCost + bestSolution.totalPenalty >= bestBeforeTabu - 0.01) {
-                cout << "[DIVERSITY] Restarting 80% of population (keeping top 20%)..." << endl;
-                
-                // Re-sort after Tabu modifications
-                iota(sortedIdx.begin(), sortedIdx.end(), 0);
-                sort(sortedIdx.begin(), sortedIdx.end(), 
-                     [&fitness](int a, int b) { return fitness[a] < fitness[b]; });
-                
-                // Keep top 20%, regenerate 80%
-                int keepCount = max(2, populationSize / 5);
-                
-                // Half from structured init, half from perturbation of best
-                int regenCount = populationSize - keepCount;
-                int fromInit = regenCount / 2;
-                int fromPerturb = regenCount - fromInit;
-                
-                auto newInds = initStructuredPopulationChromosome(fromInit, data, runNumber + generation);
-                
-                int regenIdx = 0;
-                for (int k = keepCount; k < populationSize && regenIdx < regenCount; ++k, ++regenIdx) {
-                    int idx = sortedIdx[k];
-                    if (regenIdx < fromInit && regenIdx < (int)newInds.size()) {
-                        // Structured init with full encoding
-                        population[idx] = newInds[regenIdx];
+            // Half from structured init, half from perturbation of best
+            int regenCount = populationSize - keepCount;
+            int fromInit = regenCount / 2;
+            int fromPerturb = regenCount - fromInit;
+            
+            auto newInds = initStructuredPopulationChromosome(fromInit, data, island.runSeed + generation,
+                                                              ctx.config.seed, log);
+            
+            int regenIdx = 0;
+            for (int k = keepCount; k < populationSize && regenIdx < regenCount; ++k, ++regenIdx) {
+                int idx = sortedIdx[k];
+                if (regenIdx < fromInit && regenIdx < (int)newInds.size()) {
+                    // Structured init with full encoding
+                    population[idx] = newInds[regenIdx];
+                } else {
+                    // Perturbation of best chromosome
+                    Chromosome perturbed = bestChromosome;
+                    if (regenIdx % 2 == 0) {
+                        perturbed = doubleBridgePerturbation(perturbed, rng);
                     } else {
-                        // Perturbation of best chromosome
-                        Chromosome perturbed = bestChromosome;
-                        if (regenIdx % 2 == 0) {
-                            perturbed = doubleBridgePerturbation(perturbed, rng);
-                        } else {
-                            perturbed = ruinRecreatePerturbation(perturbed, rng, 0.4);
-                        }
-                        population[idx] = perturbed;
+                        perturbed = ruinRecreatePerturbation(perturbed, rng, 0.4);
                     }
-                    PDPSolution sol = evaluateWithCache(population[idx], data, solutionCache);
-                    fitness[idx] = sol.totalCost + sol.totalPenalty;
+                    population[idx] = perturbed;
                 }
-                tabuRounds = 0;
-                cout << "[DIVERSITY] Done. Continuing GA..." << endl;
+                PDPCost sol = evaluateCostWithCache(population[idx], data, solutionCache);
+                fitness[idx] = sol.totalCost + sol.totalPenalty;
             }
+            tabuRounds = 0;
+            log << "[DIVERSITY] Done. Continuing GA..." << endl;
         }
     }
+}
+
+// Copy each island's log buffer to stdout, one "[I<k>]" prefix per line
+static void flushIslandLogs(const vector<unique_ptr<GAIsland>>& islands,
+                            vector<unique_ptr<ostringstream>>& buffers) {
+    for (size_t k = 0; k < buffers.size(); ++k) {
+        istringstream lines(buffers[k]->str());
+        string line;
+        while (getline(lines, line)) {
+            cout << "[I" << islands[k]->id << "] " << line << '\n';
+        }
+        buffers[k]->str("");
+        buffers[k]->clear();
+    }
+    cout.flush();
+}
+
+static int bestIslandIndex(const vector<unique_ptr<GAIsland>>& islands) {
+    int best = 0;
+    for (int k = 1; k < (int)islands.size(); ++k) {
+        if (islands[k]->bestFitness() < islands[best]->bestFitness()) best = k;
+    }
+    return best;
+}
+
+// Copies of the island's `count` fittest individuals, with their decoded cost
+// (population fitness may be a surrogate estimate)
+static vector<Migrant> pickEmigrants(const GAIsland& from, int count, const GAContext& ctx) {
+    vector<int> order(from.population.size());
+    iota(order.begin(), order.end(), 0);
+    count = min(count, (int)order.size());
+    partial_sort(order.begin(), order.begin() + count, order.end(),
+                 [&from](int a, int b) { return from.fitness[a] < from.fitness[b]; });
+    vector<Migrant> emigrants;
+    for (int i = 0; i < count; ++i) {
+        const Chromosome& elite = from.population[order[i]];
+        PDPCost cost = evaluateCostWithCache(elite, ctx.data, ctx.solutionCache);
+        emigrants.push_back({elite, cost.totalCost + cost.totalPenalty});
+    }
+    return emigrants;
+}
+
+// An immigrant replaces the worst individual if it is better and not already there
+static bool acceptImmigrant(GAIsland& to, const Migrant& migrant) {
+    if (to.population.empty() || migrant.first.sequence.size() != to.population[0].sequence.size()) return false;
+    if (find(to.population.begin(), to.population.end(), migrant.first) != to.population.end()) return false;
+    int worst = (int)(max_element(to.fitness.begin(), to.fitness.end()) - to.fitness.begin());
+    if (to.fitness[worst] <= migrant.second) return false;
+    to.population[worst] = migrant.first;
+    to.fitness[worst] = migrant.second;
+    return true;
+}
+
+// Elite migration: every island sends its best `migrants` individuals to the next
+// island (ring) or to a random other island. All emigrants are picked before any
+// island is changed, so the result does not depend on island order.
+// Returns the number of immigrants accepted.
+static int migrateElites(vector<unique_ptr<GAIsland>>& islands, const IslandConfig& config,
+                         mt19937& rng, const GAContext& ctx) {
+    int numIslands = (int)islands.size();
+    vector<vector<Migrant>> emigrants(numIslands);
+    for (int k = 0; k < numIslands; ++k) {
+        emigrants[k] = pickEmigrants(*islands[k], config.migrants, ctx);
+    }
+
+    int accepted = 0;
+    for (int k = 0; k < numIslands; ++k) {
+        int dest;
+        if (config.topology == MIGRATION_RANDOM) {
+            uniform_int_distribution<> pick(0, numIslands - 2);
+            dest = pick(rng);
+            if (dest >= k) dest++;
+        } else {
+            dest = (k + 1) % numIslands;
+        }
+        for (const Migrant& migrant : emigrants[k]) {
+            if (acceptImmigrant(*islands[dest], migrant)) accepted++;
+        }
+    }
+    return accepted;
+}
+
+// Swap elites with the other processes of a multi-process run: send this process's
+// best and the leading island's elites, place the returned migrants on one island
+// (rotating with the epoch)
+static void exchangeWithCoordinator(IslandLink& link, vector<unique_ptr<GAIsland>>& islands,
+                                    const IslandConfig& config, const GAContext& ctx,
+                                    int epoch, int generation) {
+    const GAIsland& leader = *islands[bestIslandIndex(islands)];
+    vector<Migrant> outgoing;
+    if (!leader.bestSequence.empty()) {
+        outgoing.push_back({leader.bestChromosome, leader.bestFitness()});
+    }
+    for (Migrant& m : pickEmigrants(leader, config.migrants, ctx)) {
+        outgoing.push_back(std::move(m));
+    }
+
+    vector<Migrant> incoming;
+    if (!link.exchange(outgoing, incoming)) return;
+    GAIsland& target = *islands[epoch % islands.size()];
+    int accepted = 0;
+    for (Migrant& migrant : incoming) {
+        // Peers may run another instance or send garbage: check the encoding and
+        // replace the fitness they claim by our own evaluation
+        if (!isValidMigrant(migrant.first, ctx.data)) continue;
+        PDPCost cost = evaluateCostWithCache(migrant.first, ctx.data, ctx.solutionCache);
+        migrant.second = cost.totalCost + cost.totalPenalty;
+        if (acceptImmigrant(target, migrant)) accepted++;
+    }
+    cout << "[MIGRATION] Gen " << generation << ": " << incoming.size() << " migrants from coordinator, "
+         << accepted << " accepted" << endl;
+}
+
+PDPSolution geneticAlgorithmPDP(const PDPData& data, const SolverConfig& config) {
+    // Base of every RNG stream of the run
+    unsigned int baseSeed = config.seed >= 0 ? (unsigned int)config.seed : random_device{}();
+    int populationSize = config.populationSize;
+    int maxGenerations = config.maxGenerations;
+    double mutationRate = config.mutationRate;
+    int runNumber = config.runNumber;
+    const IslandConfig& islandConfig = config.islands;
+    double timeLimitSec = config.timeLimitSec;
+    int numIslands = max(1, islandConfig.islands);
+    // Time limit: the GA + tabu phase gets all but finalLSTimeShare of it, the final
+    // multi-start LS the rest (plus whatever the GA leaves unused)
+    Deadline runDeadline, gaDeadline;
+    if (timeLimitSec > 0) {
+        runDeadline = Deadline::in(timeLimitSec);
+        gaDeadline = Deadline::in(timeLimitSec * (1.0 - config.finalLSTimeShare));
+    }
+    
+    cout << "\n=========================================" << endl;
+    cout << "  GENETIC ALGORITHM + TABU SEARCH (PDP)" << endl;
+    cout << "=========================================" << endl;
+    cout << "Population size: " << populationSize << endl;
+    cout << "Max generations: " << maxGenerations << endl;
+    cout << "Base mutation rate: " << mutationRate << " (adaptive)" << endl;
+    cout << "Tabu threshold: decoded-evaluation based" << endl;
+    cout << "Adaptive operators: ENABLED" << endl;
+    if (timeLimitSec > 0) {
+        cout << "Time limit: " << timeLimitSec << " s" << endl;
+    }
+    if (numIslands > 1) {
+        cout << "Islands: " << numIslands << " x " << populationSize << " ("
+             << (islandConfig.topology == MIGRATION_RANDOM ? "random" : "ring")
+             << " migration of " << islandConfig.migrants << " elites every "
+             << max(1, islandConfig.migrationInterval) << " generations)" << endl;
+    }
+    
+    // STEP 0: Initialize Solution Cache
+    // Cache persists across all generations to leverage solution reuse
+    SolutionCache solutionCache(config.cacheBudgetBytes, config.compactCache);
+    cout << "\n[0] Solution Cache initialized (budget: "
+         << solutionCache.getMemoryBudget() / (1024 * 1024) << " MB, CLOCK eviction"
+         << (config.compactCache ? ", compact" : "") << ")" << endl;
+
+    // One island: the pool evaluates offspring batches (decodes are independent;
+    // results are written per index and consumed in index order, so output matches
+    // 1 thread). Several islands: the islands run on the pool and evaluate serially.
+    ThreadPool pool(config.numThreads);
+    cout << (numIslands > 1 ? "Island threads: " : "Evaluation threads: ") << pool.size() << endl;
+
+    int tabuThreshold = config.tabuThreshold > 0 ? config.tabuThreshold :
+                        data.numCustomers <= 20 ? 
+                        max(100, populationSize * 5) :      // Small instances: trigger early Tabu
+                        max(200, populationSize * 20);      // Large instances: original threshold
+    int adaptationInterval = max(5, maxGenerations / 20);
+    // Multi-start assignment LS: the default start count does not depend on the thread
+    // count, so a seeded run draws the same random starts for any --threads
+    int tabuLSStarts = config.tabuLSStarts > 0 ? config.tabuLSStarts : 3;
+    GAContext ctx{data, solutionCache, populationSize, tabuThreshold, adaptationInterval, tabuLSStarts,
+                  gaDeadline, config};
+
+    // Each island: own RNG stream, adaptive rates and surrogate
+    vector<unique_ptr<GAIsland>> islands;
+    vector<unique_ptr<ostringstream>> islandLogs;
+    for (int k = 0; k < numIslands; ++k) {
+        islands.push_back(make_unique<GAIsland>(mutationRate));
+        GAIsland& island = *islands.back();
+        island.id = k;
+        island.rng.seed(baseSeed + runNumber * 12345 + k * 7919);
+        island.runSeed = runNumber + k * 7919;
+        if (numIslands == 1) {
+            island.evalPool = &pool;
+        } else {
+            islandLogs.push_back(make_unique<ostringstream>());
+            island.log = islandLogs.back().get();
+        }
+    }
+    
+    // Multi-process run: this process is one worker of an island coordinator
+    IslandLink link;
+    if (!islandConfig.coordinatorSocket.empty() && link.connect(islandConfig.coordinatorSocket)) {
+        cout << "Joined island coordinator at " << islandConfig.coordinatorSocket << endl;
+    }
+
+    // STEP 1: Initialize population
+    cout << "\n[1] Initializing population..." << endl;
+    if (numIslands == 1) {
+        initIsland(*islands[0], ctx);
+    } else {
+        pool.parallelFor(numIslands, [&](size_t k) { initIsland(*islands[k], ctx); });
+        flushIslandLogs(islands, islandLogs);
+    }
+
+    // STEP 2: GA Loop. Islands evolve independently between migrations; a lone
+    // island that is not linked to a coordinator runs as a single epoch.
+    mt19937 migrationRng(baseSeed + runNumber * 12345 + 1);
+    int interval = (numIslands > 1 || link.connected())
+                       ? max(1, islandConfig.migrationInterval) : max(1, maxGenerations);
+    vector<int> generationsRun(numIslands, 0);
+    for (int start = 0, epoch = 0; start < maxGenerations; start += interval, ++epoch) {
+        int end = min(maxGenerations, start + interval);
+        auto evolveEpoch = [&](size_t k) {
+            for (int generation = start; generation < end && !gaDeadline.expired(); ++generation) {
+                evolveGeneration(*islands[k], ctx, generation);
+                generationsRun[k] = generation + 1;
+            }
+        };
+        if (numIslands == 1) {
+            evolveEpoch(0);
+        } else {
+            pool.parallelFor(numIslands, evolveEpoch);
+            flushIslandLogs(islands, islandLogs);
+        }
+
+        if (gaDeadline.expired()) {
+            cout << "\n[TIME LIMIT] GA + tabu budget used up after "
+                 << *max_element(generationsRun.begin(), generationsRun.end()) << " generations" << endl;
+            break;
+        }
+        if (end < maxGenerations) {
+            if (numIslands > 1) {
+                int accepted = migrateElites(islands, islandConfig, migrationRng, ctx);
+                const GAIsland& leader = *islands[bestIslandIndex(islands)];
+                cout << "[MIGRATION] Gen " << end << ": " << accepted << " migrants accepted, best = "
+                     << fixed << setprecision(2) << leader.bestFitness() << " (island " << leader.id << ")" << endl;
+            }
+            if (link.connected()) {
+                exchangeWithCoordinator(link, islands, islandConfig, ctx, epoch, end);
+            }
+        }
+    }
+
+    // Best across islands; its RNG stream continues into the final LS
+    GAIsland& bestIsland = *islands[bestIslandIndex(islands)];
+    mt19937& rng = bestIsland.rng;
+    AdaptiveParams& adaptiveParams = bestIsland.adaptiveParams;
+    PDPSolution bestSolution = bestIsland.bestSolution;
+    vector<int> bestSequence = bestIsland.bestSequence;
+    Chromosome bestChromosome = bestIsland.bestChromosome;
+    if (numIslands > 1) {
+        cout << "\nBest island: " << bestIsland.id << endl;
+    }
     
     cout << "\n=========================================" << endl;
     cout << "  GA + TABU COMPLETED" << endl;
@@ -1520,7 +2150,8 @@ PDPSolution geneticAlgorithmPDP(const PDPData& data, int populationSize,
     
     // Final multi-start Assignment LS on the best solution
     if (!bestSequence.empty()) {
-        cout << "Running final multi-start Assignment LS (5 starts) on best solution..." << endl;
+        int finalStarts = config.finalLSStarts > 0 ? config.finalLSStarts : 5;
+        cout << "Running final multi-start Assignment LS (" << finalStarts << " starts) on best solution..." << endl;
         PDPSolution finalSol = evaluateWithCache(bestChromosome, data, solutionCache);
         double bestFit = bestSolution.totalCost + bestSolution.totalPenalty;
         double finalFit = finalSol.totalCost + finalSol.totalPenalty;
@@ -1530,30 +2161,14 @@ PDPSolution geneticAlgorithmPDP(const PDPData& data, int populationSize,
             bestChromosome = static_cast<const Chromosome&>(finalSol);
         }
         
-        // Multi-start: try 5 random assignment starts
-        for (int ms = 0; ms < 5; ms++) {
-            AssignmentEncoding randEnc;
-            int seqLen = (int)bestSequence.size();
-            randEnc.truck_assign.resize(seqLen);
-            randEnc.drone_assign.resize(seqLen);
-            randEnc.break_bit.resize(seqLen);
-            
-            uniform_int_distribution<> truckDist(0, data.numTrucks - 1);
-            uniform_int_distribution<> droneDist(0, data.numDrones);
-            uniform_int_distribution<> bitDist(0, 1);
-            
-            for (int j = 0; j < seqLen; j++) {
-                randEnc.truck_assign[j] = truckDist(rng);
-                int c = bestSequence[j];
-                if (data.isCustomer(c) && data.nodeTypes[c] == "D" && data.readyTimes[c] > 0) {
-                    randEnc.drone_assign[j] = droneDist(rng);
-                } else {
-                    randEnc.drone_assign[j] = 0;
-                }
-                randEnc.break_bit[j] = bitDist(rng);
-            }
-            
-            PDPSolution msSol = runAssignmentLS(bestSequence, randEnc, data, 50);
+        // Multi-start: random assignment starts
+        vector<PDPSolution> msSols = multiStartAssignmentLS(bestSequence, data, finalStarts, config.lsIterations,
+                                                            rng, &pool, runDeadline);
+        if ((int)msSols.size() < finalStarts) {
+            cout << "Time limit: " << msSols.size() << " of " << finalStarts << " starts run" << endl;
+        }
+        for (int ms = 0; ms < (int)msSols.size(); ms++) {
+            const PDPSolution& msSol = msSols[ms];
             double msFit = msSol.totalCost + msSol.totalPenalty;
             if (msFit < bestFit - 0.01) {
                 bestSolution = msSol;
@@ -1567,10 +2182,17 @@ PDPSolution geneticAlgorithmPDP(const PDPData& data, int populationSize,
     
     cout << "Final best cost: " << fixed << setprecision(2)
          << bestSolution.totalCost << " (penalty: " << bestSolution.totalPenalty << ")" << endl;
+    if (link.connected() && !bestSequence.empty()) {
+        link.finish({bestChromosome, bestSolution.totalCost + bestSolution.totalPenalty});
+    }
+    solutionCache.printStats();
     
     // In thß╗æng k├¬ adaptive cuß╗æi c├╣ng
     cout << "\n[ADAPTIVE STATS]" << endl;
     cout << "Final mutation rate: " << fixed << setprecision(3) << adaptiveParams.currentMutationRate << endl;
+    cout << "Surrogate: " << bestIsland.surrogate.n << " samples, rank correlation "
+         << bestIsland.surrogate.rankCorrelation << " (last generation "
+         << bestIsland.surrogate.lastRankCorrelation << ")" << endl;
     cout << "Crossover success rates: ";
     for (int i = 0; i < 4; ++i) {
         if (adaptiveParams.crossoverUsage[i] > 0) {
@@ -4,6 +4,8 @@
 #include "pdp_types.h"
 #include <vector>
 #include <random>
+#include <cstddef>
+#include <string>
 
 // ============ GA OPERATORS ============
 
@@ -26,10 +28,64 @@ void repairSequence(std::vector<int>& seq, const PDPData& data, std::mt19937& ge
 
 // ============ MAIN GA ALGORITHM ============
 
-PDPSolution geneticAlgorithmPDP(const PDPData& data,
-                               int populationSize,
-                               int maxGenerations,
-                               double mutationRate,
-                               int runNumber);
+enum MigrationTopology {
+    MIGRATION_RING = 0,    // island k sends to island k + 1
+    MIGRATION_RANDOM = 1   // each island sends to a random other island
+};
+
+// Island model: `islands` populations of populationSize individuals each evolve on
+// their own thread and exchange elites every `migrationInterval` generations.
+// islands = 1 is the classic single-population GA.
+struct IslandConfig {
+    int islands = 1;
+    int migrationInterval = 10;
+    int migrants = 2;              // Elites sent by each island per migration
+    MigrationTopology topology = MIGRATION_RING;
+    // Join a multi-process run through the coordinator's Unix socket ("" = standalone);
+    // elites are then also exchanged with the other processes every migrationInterval
+    std::string coordinatorSocket;
+};
+
+// Every tunable of a GA + tabu run. Defaults are the tuned values; fill from the
+// command line and/or a config file with setSolverOption / loadSolverConfig (pdp_config.h).
+struct SolverConfig {
+    // GA
+    int populationSize = 200;
+    int maxGenerations = 500;
+    double mutationRate = 0.15;        // Base rate, adapted during the run
+    int runNumber = 1;                 // Mixed into the RNG seeds
+    int seed = -1;                     // Fixed RNG seed, -1 = random_device. Without a time
+                                       // limit a fixed seed gives the same result for any thread
+                                       // count; only the cache statistics differ
+
+    // Offspring decoding: the best-ranked eliteDecodeShare are decoded (less as the
+    // surrogate ranks well), plus exploreDecodeShare drawn from the rest for novelty
+    double eliteDecodeShare = 0.50;
+    double exploreDecodeShare = 0.10;
+
+    // Tabu phase: starts after tabuThreshold decoded evaluations without improvement
+    // (0 = max(100, 5 x population) up to 20 customers, max(200, 20 x population) above)
+    int tabuThreshold = 0;
+    int tabuIterations = 50;
+
+    // Multi-start assignment LS (0 starts = 3 per tabu result / 5 at the end)
+    int tabuLSStarts = 0;
+    int finalLSStarts = 0;
+    int lsIterations = 50;
+
+    // Resources
+    size_t cacheBudgetBytes = 0;       // 0 = SolutionCache default
+    bool compactCache = false;         // fingerprint -> cost cache
+    int numThreads = 0;                // evaluation threads, 0 = all cores
+    IslandConfig islands;
+    double timeLimitSec = 0;           // wall-clock budget in seconds, 0 = none
+    double finalLSTimeShare = 0.15;    // share of the budget kept for the final LS
+
+    // Instance preparation (applied by the caller before the GA)
+    int depotMode = 0;                 // 0 = center, 1 = border, 2 = outside
+    int granularK = 0;                 // nearest-neighbor lists for tabu / LS, 0 = off
+};
+
+PDPSolution geneticAlgorithmPDP(const PDPData& data, const SolverConfig& config = SolverConfig());
 
 #endif // PDP_GA_H
@@ -41,7 +41,7 @@ static Chromosome makeChromosomeFromSequence(const vector<int>& seq, const PDPDa
 
     for (int i = 0; i < n; ++i) {
         int node = seq[i];
-        if (node >= 0 && node < data.numNodes && data.isCustomer(node) && data.nodeTypes[node] == "D" && data.readyTimes[node] > 0) {
+        if (data.isCustomer(node) && data.isDroneEligible(node)) {
             c.drone_assign[i] = droneDist(gen); // 0..numDrones
         } else {
             c.drone_assign[i] = 0;
@@ -56,6 +56,11 @@ static Chromosome makeChromosomeFromSequence(const vector<int>& seq, const PDPDa
         } else {
             c.break_bit[i] = breakStartDist(gen) ? 1 : 0;
         }
+
+        // A trip that would have to meet its truck out of drone range: serve by truck
+        if (c.drone_assign[i] > 0 && c.break_bit[i] == 1 && !data.isDroneReachable(node)) {
+            c.drone_assign[i] = 0;
+        }
     }
     return c;
 }
@@ -108,14 +113,14 @@ Chromosome buildHeuristicChromosome(
 
     auto isEligibleD = [&](int nodeId) -> bool {
         if (nodeId < 0 || nodeId >= data.numNodes) return false;
-        if (!data.isCustomer(nodeId)) return false;
-        return (data.nodeTypes[nodeId] == "D" && data.readyTimes[nodeId] > 0);
+        return data.isCustomer(nodeId) && data.isDroneEligible(nodeId);
     };
 
     for (int i = 0; i < n; ++i) {
         const int node_i = seq[i];
-        if (!isEligibleD(node_i)) {
-            // P, DL, or non-eligible D: not assigned to drone
+        if (!isEligibleD(node_i) || !data.isDroneReachable(node_i)) {
+            // P, DL, non-eligible D, or a D the drone cannot meet the truck at
+            // (it may still join a trip started earlier): not assigned to drone
             c.drone_assign[i] = 0;
             c.break_bit[i] = 1;
             continue;
@@ -164,13 +169,34 @@ Chromosome buildHeuristicChromosome(
 double getTruckDistance(const PDPData& data, int nodeA_id, int nodeB_id) {
     if (nodeA_id < 0 || nodeA_id >= data.numNodes || nodeB_id < 0 || nodeB_id >= data.numNodes) 
         return numeric_limits<double>::infinity();
-    return data.truckDistMatrix[nodeA_id][nodeB_id];
+    return data.truckDistMatrix(nodeA_id, nodeB_id);
 }
 
 double getDroneDistance(const PDPData& data, int nodeA_id, int nodeB_id) {
     if (nodeA_id < 0 || nodeA_id >= data.numNodes || nodeB_id < 0 || nodeB_id >= data.numNodes) 
         return numeric_limits<double>::infinity();
-    return data.droneDistMatrix[nodeA_id][nodeB_id];
+    return data.droneDistMatrix(nodeA_id, nodeB_id);
+}
+
+bool startsUnreachableDroneTrip(
+    const vector<int>& seq,
+    const vector<int>& truck_assign,
+    const vector<int>& drone_assign,
+    const vector<int>& break_bit,
+    int pos,
+    int drone,
+    const PDPData& data
+) {
+    int node = seq[pos];
+    if (drone <= 0 || !data.isCustomer(node) || !data.isDroneEligible(node) || data.isDroneReachable(node))
+        return false;
+    if (break_bit[pos] == 1) return true;
+    for (int k = pos - 1; k >= 0; --k) {
+        if (drone_assign[k] == drone && truck_assign[k] == truck_assign[pos] &&
+            data.isCustomer(seq[k]) && data.isDroneEligible(seq[k]))
+            return false;
+    }
+    return true;
 }
 
 // Hàm polarAngle (giữ nguyên từ file của bạn)
@@ -296,10 +322,10 @@ void quickRepairPDP(vector<int>& seq, const PDPData& data, mt19937& gen) {
         if (nodeIdx >= 0 && nodeIdx < (int)data.pairIds.size()) {
             int pairId = data.pairIds[nodeIdx];
             if (pairId > 0) {
-                if (data.nodeTypes[nodeIdx] == "P") {
+                if (data.nodeKind[nodeIdx] == NODE_P) {
                     pairToNodeP[pairId] = nodeIdx;
                     positionP[pairId] = i;
-                } else if (data.nodeTypes[nodeIdx] == "DL") {
+                } else if (data.nodeKind[nodeIdx] == NODE_DL) {
                     pairToNodeDL[pairId] = nodeIdx;
                     positionDL[pairId] = i;
                 }
@@ -326,10 +352,8 @@ void quickRepairPDP(vector<int>& seq, const PDPData& data, mt19937& gen) {
 // ============ INITIALIZATION METHODS (VIẾT LẠI - KHÔNG CÓ SEPARATOR) ============
 
 // Hàm Random: Chọn ngẫu nhiên khách hàng tiếp theo
-vector<vector<int>> initRandomPDP(int populationSize, const PDPData& data) {
+vector<vector<int>> initRandomPDP(int populationSize, const PDPData& data, mt19937& gen) {
     vector<vector<int>> population;
-    random_device rd;
-    mt19937 gen(rd());
     
     vector<int> customers = getAllCustomerNodes(data);
     
@@ -344,10 +368,8 @@ vector<vector<int>> initRandomPDP(int populationSize, const PDPData& data) {
 }
 
 // Hàm Greedy Time: Tham lam theo ready_time + thời gian đi
-vector<vector<int>> initGreedyTimePDP(int populationSize, const PDPData& data) {
+vector<vector<int>> initGreedyTimePDP(int populationSize, const PDPData& data, mt19937& gen) {
     vector<vector<int>> population;
-    random_device rd;
-    mt19937 gen(rd());
     vector<vector<double>> dist = buildDistanceMatrix(data);
     
     for (int p = 0; p < populationSize; ++p) {
@@ -401,10 +423,8 @@ vector<vector<int>> initGreedyTimePDP(int populationSize, const PDPData& data) {
 }
 
 // Hàm Sweep: Tham lam theo góc (polar angle)
-vector<vector<int>> initSweepPDP(int populationSize, const PDPData& data) {
+vector<vector<int>> initSweepPDP(int populationSize, const PDPData& data, mt19937& gen) {
     vector<vector<int>> population;
-    random_device rd;
-    mt19937 gen(rd());
     pair<double,double> depotCoords = data.coordinates[data.depotIndex];
     
     for (int p = 0; p < populationSize; ++p) {
@@ -457,10 +477,8 @@ vector<vector<int>> initSweepPDP(int populationSize, const PDPData& data) {
 }
 
 // Hàm Nearest Neighbor: Tham lam theo khoảng cách gần nhất
-vector<vector<int>> initNearestNeighborPDP(int populationSize, const PDPData& data) {
+vector<vector<int>> initNearestNeighborPDP(int populationSize, const PDPData& data, mt19937& gen) {
     vector<vector<int>> population;
-    random_device rd;
-    mt19937 gen(rd());
     vector<vector<double>> dist = buildDistanceMatrix(data);
     
     for (int p = 0; p < populationSize; ++p) {
@@ -507,46 +525,50 @@ vector<vector<int>> initNearestNeighborPDP(int populationSize, const PDPData& da
     return population;
 }
 
+// Seed of an init RNG stream: random_device unless a fixed seed is given
+static unsigned int initSeed(int runNumber, int seed) {
+    unsigned int base = seed >= 0 ? (unsigned int)seed : random_device{}();
+    return base + runNumber * 54321;
+}
+
 // Hàm kết hợp: 10% Random, 30% GreedyTime, 30% Sweep, 30% NN
-vector<vector<int>> initStructuredPopulationPDP(int populationSize, const PDPData& data, int runNumber) {
-    random_device rd;
-    unsigned int seed = rd() + runNumber * 54321;
-    mt19937 gen(seed);
+vector<vector<int>> initStructuredPopulationPDP(int populationSize, const PDPData& data, int runNumber, int seed,
+                                                ostream& log) {
+    mt19937 gen(initSeed(runNumber, seed));
     
     int randomCount = (int)(populationSize * 0.10);      // 10%
     int greedyTimeCount = (int)(populationSize * 0.30);  // 30%
     int sweepCount = (int)(populationSize * 0.30);       // 30%
     int nnCount = populationSize - randomCount - greedyTimeCount - sweepCount; // 30%
     
-    cout << "PDP Population distribution (NO SEPARATOR):" << endl;
-    cout << "   Random: " << randomCount << endl;
-    cout << "   Greedy Time: " << greedyTimeCount << endl;
-    cout << "   Sweep: " << sweepCount << endl;
-    cout << "   Nearest Neighbor: " << nnCount << endl;
+    log << "PDP Population distribution (NO SEPARATOR):" << endl;
+    log << "   Random: " << randomCount << endl;
+    log << "   Greedy Time: " << greedyTimeCount << endl;
+    log << "   Sweep: " << sweepCount << endl;
+    log << "   Nearest Neighbor: " << nnCount << endl;
     
     vector<vector<int>> population;
     
-    auto randomPop = initRandomPDP(randomCount, data);
+    auto randomPop = initRandomPDP(randomCount, data, gen);
     population.insert(population.end(), randomPop.begin(), randomPop.end());
     
-    auto greedyTimePop = initGreedyTimePDP(greedyTimeCount, data);
+    auto greedyTimePop = initGreedyTimePDP(greedyTimeCount, data, gen);
     population.insert(population.end(), greedyTimePop.begin(), greedyTimePop.end());
     
-    auto sweepPop = initSweepPDP(sweepCount, data);
+    auto sweepPop = initSweepPDP(sweepCount, data, gen);
     population.insert(population.end(), sweepPop.begin(), sweepPop.end());
     
-    auto nnPop = initNearestNeighborPDP(nnCount, data);
+    auto nnPop = initNearestNeighborPDP(nnCount, data, gen);
     population.insert(population.end(), nnPop.begin(), nnPop.end());
-    cout << "Generated " << population.size() << " PDP individuals (sequence only, no separators)" << endl;
+    log << "Generated " << population.size() << " PDP individuals (sequence only, no separators)" << endl;
     return population;
 }
 
-vector<Chromosome> initStructuredPopulationChromosome(int populationSize, const PDPData& data, int runNumber) {
-    random_device rd;
-    unsigned int seed = rd() + runNumber * 54321;
-    mt19937 gen(seed);
+vector<Chromosome> initStructuredPopulationChromosome(int populationSize, const PDPData& data, int runNumber,
+                                                      int seed, ostream& log) {
+    mt19937 gen(initSeed(runNumber, seed) + 1);
 
-    vector<vector<int>> seqs = initStructuredPopulationPDP(populationSize, data, runNumber);
+    vector<vector<int>> seqs = initStructuredPopulationPDP(populationSize, data, runNumber, seed, log);
     vector<Chromosome> pop;
     pop.reserve(seqs.size());
     for (const auto& s : seqs) {
@@ -4,6 +4,7 @@
 #include "pdp_types.h"
 #include <vector>
 #include <random>
+#include <iostream>
 
 using namespace std;
 
@@ -53,13 +54,35 @@ void quickRepairPDP(vector<int>& seq, const PDPData& data, mt19937& gen);
  * to maximize population diversity for genetic search.
  * @param populationSize Desired number of individuals
  * @param data PDP instance
- * @param runNumber Seed parameter for reproducibility
+ * @param runNumber Mixed into the RNG seed
+ * @param seed Fixed RNG seed for a reproducible population, -1 = random_device
+ * @param log Receives the population breakdown (the island log in an island run)
  * @return Vector of initial chromosome solutions
  */
-vector<vector<int>> initStructuredPopulationPDP(int populationSize, const PDPData& data, int runNumber = 1);
+vector<vector<int>> initStructuredPopulationPDP(int populationSize, const PDPData& data, int runNumber = 1,
+                                                int seed = -1, ostream& log = cout);
+
+/**
+ * @brief True if giving drone `drone` (> 0) to position pos certainly makes it the
+ * rendezvous of a new drone trip at a customer the drone cannot reach
+ * (PDPData::isDroneReachable), i.e. the decode is bound to take the infeasible-trip
+ * penalty: the node is drone-eligible and either break_bit[pos] is 1 or no earlier
+ * position has the same truck and drone. Only looks at positions before pos.
+ */
+bool startsUnreachableDroneTrip(
+	const std::vector<int>& seq,
+	const std::vector<int>& truck_assign,
+	const std::vector<int>& drone_assign,
+	const std::vector<int>& break_bit,
+	int pos,
+	int drone,
+	const PDPData& data
+);
 
 // New API: initialize full chromosome encoding (sequence + truck/drone/break arrays).
-vector<Chromosome> initStructuredPopulationChromosome(int populationSize, const PDPData& data, int runNumber = 1);
+// runNumber, seed and log as for initStructuredPopulationPDP.
+vector<Chromosome> initStructuredPopulationChromosome(int populationSize, const PDPData& data, int runNumber = 1,
+                                                      int seed = -1, ostream& log = cout);
 
 // Build heuristic encoding (drone_assign + break_bit) given seq + truck_assign.
 // This function does NOT decode or simulate time; it only constructs a full Chromosome.
@@ -73,35 +96,39 @@ Chromosome buildHeuristicChromosome(
  * @brief Generate population with completely random sequences.
  * @param populationSize Number of individuals
  * @param data PDP instance
+ * @param gen Random number generator
  * @return Vector of random chromosomes
  */
-vector<vector<int>> initRandomPDP(int populationSize, const PDPData& data);
+vector<vector<int>> initRandomPDP(int populationSize, const PDPData& data, mt19937& gen);
 
 /**
  * @brief Generate population using Sweep algorithm (polar angle ordering).
  * Orders customers by angle from depot center for structured solution diversity.
  * @param populationSize Number of individuals
  * @param data PDP instance
+ * @param gen Random number generator
  * @return Vector of sweep-based chromosomes
  */
-vector<vector<int>> initSweepPDP(int populationSize, const PDPData& data);
+vector<vector<int>> initSweepPDP(int populationSize, const PDPData& data, mt19937& gen);
 
 /**
  * @brief Generate population using Greedy Time heuristic.
  * Prioritizes customers with earliest ready times for time-window feasibility.
  * @param populationSize Number of individuals
  * @param data PDP instance
+ * @param gen Random number generator
  * @return Vector of greedy-constructed chromosomes
  */
-vector<vector<int>> initGreedyTimePDP(int populationSize, const PDPData& data);
+vector<vector<int>> initGreedyTimePDP(int populationSize, const PDPData& data, mt19937& gen);
 
 /**
  * @brief Generate population using Nearest Neighbor constructive heuristic.
  * Each individual built by repeatedly selecting nearest unserved customer.
  * @param populationSize Number of individuals
  * @param data PDP instance
+ * @param gen Random number generator
  * @return Vector of nearest-neighbor chromosomes
  */
-vector<vector<int>> initNearestNeighborPDP(int populationSize, const PDPData& data);
+vector<vector<int>> initNearestNeighborPDP(int populationSize, const PDPData& data, mt19937& gen);
 
 #endif
@@ -132,18 +132,18 @@ void IntegratedLocalSearch::printOperatorStats() const {
 double IntegratedLocalSearch::getTruckTravelTime(int from, int to) const {
     if (from < 0 || from >= data.numNodes || to < 0 || to >= data.numNodes)
         return numeric_limits<double>::infinity();
-    return data.truckDistMatrix[from][to] / data.truckSpeed * 60.0;
+    return data.truckDistMatrix(from, to) / data.truckSpeed * 60.0;
 }
 
 double IntegratedLocalSearch::getDroneTravelTime(int from, int to) const {
     if (from < 0 || from >= data.numNodes || to < 0 || to >= data.numNodes)
         return numeric_limits<double>::infinity();
-    return data.droneDistMatrix[from][to] / data.droneSpeed * 60.0;
+    return data.droneDistMatrix(from, to) / data.droneSpeed * 60.0;
 }
 
 bool IntegratedLocalSearch::isDroneEligible(int node_id) const {
     if (node_id < 0 || node_id >= data.numNodes) return false;
-    return (data.nodeTypes[node_id] == "D" && data.readyTimes[node_id] > 0);
+    return data.isDroneEligible(node_id);
 }
 
 double IntegratedLocalSearch::calculateCmax(const PDPSolution& sol) const {
@@ -366,19 +366,19 @@ bool IntegratedLocalSearch::isTruckRouteFeasible(const vector<int>& route, int t
         
         if (!data.isCustomer(node)) continue;
         
-        string type = data.nodeTypes[node];
+        const uint8_t kind = data.nodeKind[node];
         int demand = data.demands[node];
         int pair_id = data.pairIds[node];
         
         // Check P-DL precedence
-        if (type == "DL" && pair_id > 0) {
+        if (kind == NODE_DL && pair_id > 0) {
             if (picked_up_pairs.find(pair_id) == picked_up_pairs.end()) {
                 return false; // DL before P
             }
             picked_up_pairs.erase(pair_id);
         }
         
-        if (type == "P" && pair_id > 0) {
+        if (kind == NODE_P && pair_id > 0) {
             picked_up_pairs.insert(pair_id);
         }
         
@@ -416,7 +416,7 @@ bool IntegratedLocalSearch::isDroneTripFeasible(const ResupplyEvent& trip, const
             if (abs(ready - first_ready) > 30) return false;
             
             // Distance constraint from first customer (resupply point)
-            double dist = data.droneDistMatrix[trip.customer_ids[0]][cust];
+            double dist = data.droneDistMatrix(trip.customer_ids[0], cust);
             if (dist > 10.0) return false;
         }
     }
@@ -499,13 +499,18 @@ double IntegratedLocalSearch::evaluateDroneTripTime(
 bool IntegratedLocalSearch::truck2Opt(PDPSolution& sol) {
     bool improved = false;
     double best_cmax = calculateCmax(sol);
+    GranularIndex granular;
+    vector<int> candidates;
     
     for (auto& truck : sol.truck_details) {
         if (truck.route.size() < 4) continue; // Need at least depot-a-b-depot
+        granular.build(data, truck.route);
         
-        // Try all 2-opt moves (excluding depot)
+        // Try all 2-opt moves (excluding depot); granular: new edge route[i-1] -> route[j]
         for (size_t i = 1; i < truck.route.size() - 2; ++i) {
-            for (size_t j = i + 1; j < truck.route.size() - 1; ++j) {
+            granular.candidates(truck.route[i - 1], (int)i + 1, (int)truck.route.size() - 1, candidates);
+            for (int jp : candidates) {
+                size_t j = jp;
                 // Reverse segment [i, j]
                 vector<int> new_route = truck.route;
                 reverse(new_route.begin() + i, new_route.begin() + j + 1);
@@ -590,12 +595,18 @@ bool IntegratedLocalSearch::truckOrOpt(PDPSolution& sol) {
 bool IntegratedLocalSearch::truckSwap(PDPSolution& sol) {
     bool improved = false;
     double best_cmax = calculateCmax(sol);
+    GranularIndex granular;
+    vector<int> candidates;
     
     for (auto& truck : sol.truck_details) {
         if (truck.route.size() < 4) continue;
+        granular.build(data, truck.route);
         
         for (size_t i = 1; i < truck.route.size() - 1; ++i) {
-            for (size_t j = i + 1; j < truck.route.size() - 1; ++j) {
+            // Granular: route[j] in route[i]'s candidate list
+            granular.candidates(truck.route[i], (int)i + 1, (int)truck.route.size() - 1, candidates);
+            for (int jp : candidates) {
+                size_t j = jp;
                 // Swap nodes at i and j
                 vector<int> new_route = truck.route;
                 swap(new_route[i], new_route[j]);
@@ -627,14 +638,20 @@ bool IntegratedLocalSearch::truckSwap(PDPSolution& sol) {
 bool IntegratedLocalSearch::truckRelocate(PDPSolution& sol) {
     bool improved = false;
     double best_cmax = calculateCmax(sol);
+    GranularIndex granular;
+    vector<int> candidates;
     
     for (auto& truck : sol.truck_details) {
         if (truck.route.size() < 4) continue;
+        granular.build(data, truck.route);
         
         for (size_t i = 1; i < truck.route.size() - 1; ++i) {
             int node = truck.route[i];
             
-            for (size_t j = 1; j < truck.route.size() - 1; ++j) {
+            // Granular: route[j] in node's candidate list
+            granular.candidates(node, 1, (int)truck.route.size() - 1, candidates);
+            for (int jp : candidates) {
+                size_t j = jp;
                 if (j == i || j == i - 1) continue;
                 
                 // Move node from position i to after position j
@@ -914,7 +931,7 @@ bool IntegratedLocalSearch::droneInsertIntoTrip(PDPSolution& sol) {
             
             // Distance constraint: candidate phai < 10km tu resupply point (first customer)
             if (can_consolidate) {
-                double dist = data.droneDistMatrix[first_cust][candidate];
+                double dist = data.droneDistMatrix(first_cust, candidate);
                 if (dist > 10.0) {
                     can_consolidate = false;
                 }
@@ -1594,7 +1611,7 @@ int IntegratedLocalSearch::findLongestRoute(const PDPSolution& sol) const {
         
         // Sum distances in the route
         for (size_t j = 1; j < truck.route.size(); ++j) {
-            route_distance += data.truckDistMatrix[truck.route[j-1]][truck.route[j]];
+            route_distance += data.truckDistMatrix(truck.route[j-1], truck.route[j]);
         }
         
         if (route_distance > max_distance) {
@@ -0,0 +1,375 @@
+#include "pdp_migration.h"
+#include "pdp_fitness.h"
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <deque>
+#include <chrono>
+
+using namespace std;
+
+// ============ WIRE FORMAT ============
+// Every message: uint32 type, uint32 migrant count, uint32 payload bytes, payload.
+// A migrant is its fitness (double) followed by the four encoding vectors
+// (sequence, truck_assign, drone_assign, break_bit), each an int32 length + int32 genes.
+// Both ends run on the same host, so native byte order is used.
+
+enum MigrationMessage {
+    MSG_MIGRATE = 1,    // worker -> coordinator: best so far + elites
+    MSG_MIGRANTS = 2,   // coordinator -> worker: queued immigrants
+    MSG_DONE = 3        // worker -> coordinator: final best, then close
+};
+
+static const uint32_t MAX_PAYLOAD_BYTES = 64u * 1024 * 1024;
+static const size_t MAX_MAILBOX = 64;  // Queued migrants per worker (oldest dropped)
+static const int CONNECT_TIMEOUT_SEC = 60;  // Coordinator stops waiting for workers after this long without a new one
+
+static void appendBytes(vector<char>& buf, const void* src, size_t n) {
+    const char* p = static_cast<const char*>(src);
+    buf.insert(buf.end(), p, p + n);
+}
+
+static vector<char> encodeMigrants(const vector<Migrant>& migrants) {
+    vector<char> buf;
+    for (const Migrant& m : migrants) {
+        appendBytes(buf, &m.second, sizeof(double));
+        for (int f = 0; f < 4; ++f) {
+            const vector<int>& genes = m.first.field(f);
+            int32_t len = (int32_t)genes.size();
+            appendBytes(buf, &len, sizeof(len));
+            for (int g : genes) {
+                int32_t v = g;
+                appendBytes(buf, &v, sizeof(v));
+            }
+        }
+    }
+    return buf;
+}
+
+static bool decodeMigrants(const vector<char>& buf, uint32_t count, vector<Migrant>& out) {
+    size_t pos = 0;
+    auto take = [&](void* dst, size_t n) {
+        if (pos + n > buf.size()) return false;
+        memcpy(dst, buf.data() + pos, n);
+        pos += n;
+        return true;
+    };
+    for (uint32_t k = 0; k < count; ++k) {
+        Migrant m;
+        if (!take(&m.second, sizeof(double))) return false;
+        for (int f = 0; f < 4; ++f) {
+            int32_t len = 0;
+            if (!take(&len, sizeof(len)) || len < 0 || (size_t)len * sizeof(int32_t) > buf.size() - pos) return false;
+            vector<int>& genes = m.first.field(f);
+            genes.resize(len);
+            for (int32_t i = 0; i < len; ++i) {
+                int32_t v;
+                if (!take(&v, sizeof(v))) return false;
+                genes[i] = v;
+            }
+        }
+        m.first.refreshFingerprint();
+        out.push_back(m);
+    }
+    return pos == buf.size();
+}
+
+static bool writeAll(int fd, const char* p, size_t n) {
+    while (n > 0) {
+        ssize_t w = send(fd, p, n, MSG_NOSIGNAL);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) return false;
+        p += w;
+        n -= (size_t)w;
+    }
+    return true;
+}
+
+static bool readAll(int fd, char* p, size_t n) {
+    while (n > 0) {
+        ssize_t r = recv(fd, p, n, 0);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return false;
+        p += r;
+        n -= (size_t)r;
+    }
+    return true;
+}
+
+static bool sendMessage(int fd, uint32_t type, const vector<Migrant>& migrants) {
+    vector<char> payload = encodeMigrants(migrants);
+    uint32_t header[3] = {type, (uint32_t)migrants.size(), (uint32_t)payload.size()};
+    vector<char> msg;
+    msg.reserve(sizeof(header) + payload.size());
+    appendBytes(msg, header, sizeof(header));
+    msg.insert(msg.end(), payload.begin(), payload.end());
+    return writeAll(fd, msg.data(), msg.size());
+}
+
+static bool receiveMessage(int fd, uint32_t& type, vector<Migrant>& migrants) {
+    uint32_t header[3];
+    if (!readAll(fd, reinterpret_cast<char*>(header), sizeof(header))) return false;
+    if (header[2] > MAX_PAYLOAD_BYTES) return false;
+    vector<char> payload(header[2]);
+    if (!readAll(fd, payload.data(), payload.size())) return false;
+    type = header[0];
+    return decodeMigrants(payload, header[1], migrants);
+}
+
+static bool makeSocketAddress(const string& socketPath, sockaddr_un& addr) {
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (socketPath.empty() || socketPath.size() >= sizeof(addr.sun_path)) {
+        cerr << "[MIGRATION] Invalid socket path: " << socketPath << endl;
+        return false;
+    }
+    memcpy(addr.sun_path, socketPath.c_str(), socketPath.size());
+    return true;
+}
+
+bool isValidMigrant(const Chromosome& chromo, const PDPData& data) {
+    int n = data.numCustomers;
+    if ((int)chromo.sequence.size() != n || (int)chromo.truck_assign.size() != n ||
+        (int)chromo.drone_assign.size() != n || (int)chromo.break_bit.size() != n) {
+        return false;
+    }
+    vector<char> seen(data.numNodes, 0);
+    for (int i = 0; i < n; ++i) {
+        int node = chromo.sequence[i];
+        if (!data.isCustomer(node) || seen[node]) return false;
+        seen[node] = 1;
+        if (chromo.truck_assign[i] < 0 || chromo.truck_assign[i] >= data.numTrucks) return false;
+        if (chromo.drone_assign[i] < 0 || chromo.drone_assign[i] > data.numDrones) return false;
+        if (chromo.break_bit[i] != 0 && chromo.break_bit[i] != 1) return false;
+    }
+    return true;
+}
+
+// ============ WORKER ============
+
+IslandLink::~IslandLink() {
+    close();
+}
+
+void IslandLink::close() {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+bool IslandLink::connect(const string& socketPath) {
+    close();
+    sockaddr_un addr;
+    if (!makeSocketAddress(socketPath, addr)) return false;
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        cerr << "[MIGRATION] socket() failed: " << strerror(errno) << endl;
+        return false;
+    }
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        cerr << "[MIGRATION] Cannot reach coordinator at " << socketPath << ": " << strerror(errno) << endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool IslandLink::exchange(const vector<Migrant>& emigrants, vector<Migrant>& immigrants) {
+    if (fd < 0) return false;
+    uint32_t type = 0;
+    immigrants.clear();
+    if (!sendMessage(fd, MSG_MIGRATE, emigrants) ||
+        !receiveMessage(fd, type, immigrants) || type != MSG_MIGRANTS) {
+        cerr << "[MIGRATION] Lost coordinator, continuing standalone" << endl;
+        immigrants.clear();
+        close();
+        return false;
+    }
+    return true;
+}
+
+void IslandLink::finish(const Migrant& best) {
+    if (fd < 0) return;
+    sendMessage(fd, MSG_DONE, vector<Migrant>(1, best));
+    close();
+}
+
+// ============ COORDINATOR ============
+
+PDPSolution runIslandCoordinator(const PDPData& data, const string& socketPath,
+                                 int expectedWorkers, MigrationTopology topology) {
+    PDPSolution best;
+    best.totalCost = numeric_limits<double>::infinity();
+
+    sockaddr_un addr;
+    if (!makeSocketAddress(socketPath, addr)) return best;
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        cerr << "[COORDINATOR] socket() failed: " << strerror(errno) << endl;
+        return best;
+    }
+    unlink(socketPath.c_str());
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(listenFd, expectedWorkers) < 0) {
+        cerr << "[COORDINATOR] Cannot listen on " << socketPath << ": " << strerror(errno) << endl;
+        ::close(listenFd);
+        return best;
+    }
+    cout << "[COORDINATOR] Listening on " << socketPath << " for " << expectedWorkers << " workers" << endl;
+
+    vector<int> workerFd;                 // -1 once a worker has finished or failed
+    vector<deque<Migrant>> mailbox;
+    Chromosome bestChromosome;
+    double bestFitness = numeric_limits<double>::infinity();
+    int bestWorker = -1;
+    mt19937 rng(random_device{}());
+
+    // The reported fitness is not trusted: the global best is ranked by a local decode
+    auto report = [&](int worker, const Migrant& m) {
+        if (!isValidMigrant(m.first, data)) return;
+        PDPCost cost = decodeCostOnly(m.first, data);
+        double fitness = cost.totalCost + cost.totalPenalty;
+        if (fitness < bestFitness) {
+            bestFitness = fitness;
+            bestChromosome = m.first;
+            bestWorker = worker;
+            cout << "[COORDINATOR] New global best " << fixed << setprecision(2) << bestFitness
+                 << " from worker " << worker << endl;
+        }
+    };
+
+    auto destinationOf = [&](int worker) {
+        int n = (int)workerFd.size();
+        if (topology == MIGRATION_RANDOM) {
+            vector<int> live;
+            for (int k = 0; k < n; ++k) {
+                if (k != worker && workerFd[k] >= 0) live.push_back(k);
+            }
+            if (live.empty()) return -1;
+            return live[uniform_int_distribution<>(0, (int)live.size() - 1)(rng)];
+        }
+        for (int step = 1; step < n; ++step) {
+            int k = (worker + step) % n;
+            if (workerFd[k] >= 0) return k;
+        }
+        return -1;
+    };
+
+    auto drop = [&](int worker, const char* reason) {
+        ::close(workerFd[worker]);
+        workerFd[worker] = -1;
+        mailbox[worker].clear();
+        cout << "[COORDINATOR] Worker " << worker << " " << reason << endl;
+    };
+
+    // Accept workers until all expected ones are in, CONNECT_TIMEOUT_SEC pass without a
+    // new one, or every connected worker has already finished (one that crashed at
+    // start-up never connects); then run until the connected ones are done.
+    int liveWorkers = 0;
+    bool accepting = true;
+    auto lastConnect = chrono::steady_clock::now();
+    while (accepting || liveWorkers > 0) {
+        if (accepting) {
+            double idle = chrono::duration<double>(chrono::steady_clock::now() - lastConnect).count();
+            if ((int)workerFd.size() >= expectedWorkers || idle >= CONNECT_TIMEOUT_SEC ||
+                (!workerFd.empty() && liveWorkers == 0)) {
+                accepting = false;
+                if ((int)workerFd.size() < expectedWorkers) {
+                    cout << "[COORDINATOR] Stopped waiting for workers: " << workerFd.size() << "/"
+                         << expectedWorkers << " connected" << endl;
+                }
+                continue;
+            }
+        }
+        vector<pollfd> fds;
+        vector<int> owner;
+        int timeoutMs = -1;
+        if (accepting) {
+            fds.push_back({listenFd, POLLIN, 0});
+            owner.push_back(-1);
+            double idle = chrono::duration<double>(chrono::steady_clock::now() - lastConnect).count();
+            timeoutMs = max(1, (int)((CONNECT_TIMEOUT_SEC - idle) * 1000.0));
+        }
+        for (int k = 0; k < (int)workerFd.size(); ++k) {
+            if (workerFd[k] >= 0) {
+                fds.push_back({workerFd[k], POLLIN, 0});
+                owner.push_back(k);
+            }
+        }
+        if (poll(fds.data(), fds.size(), timeoutMs) < 0) {
+            if (errno == EINTR) continue;
+            cerr << "[COORDINATOR] poll() failed: " << strerror(errno) << endl;
+            break;
+        }
+
+        for (size_t p = 0; p < fds.size(); ++p) {
+            if (!fds[p].revents) continue;
+            int worker = owner[p];
+            if (worker < 0) {
+                int fd = accept(listenFd, nullptr, nullptr);
+                if (fd < 0) continue;
+                workerFd.push_back(fd);
+                mailbox.emplace_back();
+                liveWorkers++;
+                lastConnect = chrono::steady_clock::now();
+                cout << "[COORDINATOR] Worker " << workerFd.size() - 1 << " connected ("
+                     << workerFd.size() << "/" << expectedWorkers << ")" << endl;
+                continue;
+            }
+
+            uint32_t type = 0;
+            vector<Migrant> migrants;
+            if (!receiveMessage(workerFd[worker], type, migrants)) {
+                drop(worker, "disconnected");
+                liveWorkers--;
+                continue;
+            }
+            if (!migrants.empty()) report(worker, migrants[0]);
+
+            if (type == MSG_DONE) {
+                drop(worker, "finished");
+                liveWorkers--;
+                continue;
+            }
+            if (type != MSG_MIGRATE) {
+                drop(worker, "sent an unknown message");
+                liveWorkers--;
+                continue;
+            }
+
+            int dest = destinationOf(worker);
+            if (dest >= 0) {
+                for (Migrant& m : migrants) {
+                    if (!isValidMigrant(m.first, data)) continue;
+                    mailbox[dest].push_back(std::move(m));
+                    if (mailbox[dest].size() > MAX_MAILBOX) mailbox[dest].pop_front();
+                }
+            }
+            vector<Migrant> outgoing(mailbox[worker].begin(), mailbox[worker].end());
+            mailbox[worker].clear();
+            if (!sendMessage(workerFd[worker], MSG_MIGRANTS, outgoing)) {
+                drop(worker, "disconnected");
+                liveWorkers--;
+            }
+        }
+    }
+
+    ::close(listenFd);
+    unlink(socketPath.c_str());
+
+    if (bestWorker >= 0) {
+        cout << "[COORDINATOR] Global best " << fixed << setprecision(2) << bestFitness
+             << " (worker " << bestWorker << ")" << endl;
+        best = decodeFromEncoding(bestChromosome, data);
+    }
+    return best;
+}
@@ -0,0 +1,74 @@
+#ifndef PDP_MIGRATION_H
+#define PDP_MIGRATION_H
+
+#include "pdp_types.h"
+#include "pdp_ga.h"
+#include <string>
+#include <vector>
+#include <utility>
+
+// A chromosome sent between islands, paired with its decoded fitness (cost + penalty)
+typedef std::pair<Chromosome, double> Migrant;
+
+/**
+ * @brief Worker side of a multi-process island run.
+ *
+ * Several main_ga_tabu processes (each running the GA, optionally with its own
+ * islands) connect to one coordinator over a Unix domain socket. At every
+ * migration they send their best chromosome and elites, and in return get the
+ * migrants that other workers have sent to them so far. The exchange never
+ * waits for other workers. Nothing leaves the machine.
+ *
+ * A failed connect or exchange closes the link and the GA continues on its own,
+ * so a crashed coordinator or worker does not take the others down.
+ */
+class IslandLink {
+public:
+    IslandLink() = default;
+    ~IslandLink();
+
+    IslandLink(const IslandLink&) = delete;
+    IslandLink& operator=(const IslandLink&) = delete;
+
+    // Connect to the coordinator listening on socketPath; false if unreachable
+    bool connect(const std::string& socketPath);
+    bool connected() const { return fd >= 0; }
+
+    /**
+     * @brief Send emigrants (the first one is this worker's best so far) and
+     * receive the migrants queued for this worker.
+     * @return false if the link failed (it is closed afterwards)
+     */
+    bool exchange(const std::vector<Migrant>& emigrants, std::vector<Migrant>& immigrants);
+
+    // Report the final best and close the link
+    void finish(const Migrant& best);
+
+private:
+    int fd = -1;
+
+    void close();
+};
+
+// True if chromo is a well-formed encoding for this instance: its sequence is a
+// permutation of the customers and the assignment vectors match it in length and range.
+// Migrants from other processes are checked with it before they are decoded.
+bool isValidMigrant(const Chromosome& chromo, const PDPData& data);
+
+/**
+ * @brief Run the coordinator of a multi-process island run.
+ *
+ * Listens on socketPath (replacing any stale socket file) until expectedWorkers
+ * workers have connected (or none has connected for a minute, or all connected ones
+ * are already done) and all of them have finished or disconnected. Malformed
+ * migrants are dropped, and reported bests are ranked by a local decode. Each
+ * worker's emigrants are queued for the next live worker (ring) or a random live
+ * worker; a worker that disconnects is dropped from the ring. The best chromosome
+ * reported by any worker is tracked throughout.
+ *
+ * @return Full decode of the global best (totalCost = +inf if no worker reported)
+ */
+PDPSolution runIslandCoordinator(const PDPData& data, const std::string& socketPath,
+                                 int expectedWorkers, MigrationTopology topology);
+
+#endif // PDP_MIGRATION_H
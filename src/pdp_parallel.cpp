@@ -0,0 +1,99 @@
+#include "pdp_parallel.h"
+
+using namespace std;
+
+int ThreadPool::resolveThreadCount(int requested) {
+    if (requested > 0) return requested;
+    unsigned hw = thread::hardware_concurrency();
+    return hw > 0 ? (int)hw : 1;
+}
+
+ThreadPool::ThreadPool(int numThreads) {
+    int total = resolveThreadCount(numThreads);
+    workers.reserve(total - 1);
+    for (int i = 1; i < total; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& w : workers) {
+        w.join();
+    }
+}
+
+// Claim indices of the job (fn, n) until it is exhausted. The job is passed in, as read
+// under the lock, so the shared fields are never read while parallelFor may rewrite them.
+void ThreadPool::runChunk(const function<void(size_t)>& fn, size_t n) {
+    while (true) {
+        size_t i = next.fetch_add(1, memory_order_relaxed);
+        if (i >= n) break;
+        try {
+            fn(i);
+        } catch (...) {
+            lock_guard<mutex> guard(lock);
+            if (!error) error = current_exception();
+            next.store(n, memory_order_relaxed);  // stop handing out work
+        }
+    }
+}
+
+void ThreadPool::workerLoop() {
+    unsigned long long seenJob = 0;
+    while (true) {
+        const function<void(size_t)>* fn;
+        size_t n;
+        {
+            unique_lock<mutex> guard(lock);
+            wake.wait(guard, [&] { return stopping || jobId != seenJob; });
+            if (stopping) return;
+            seenJob = jobId;
+            if (!body) continue;   // Woke after the caller already finished this job
+            fn = body;
+            n = count;
+            busyWorkers++;
+        }
+        runChunk(*fn, n);
+        {
+            lock_guard<mutex> guard(lock);
+            busyWorkers--;
+        }
+        finished.notify_one();
+    }
+}
+
+void ThreadPool::parallelFor(size_t n, const function<void(size_t)>& fn) {
+    if (n == 0) return;
+    if (workers.empty() || n == 1) {
+        for (size_t i = 0; i < n; ++i) fn(i);
+        return;
+    }
+
+    {
+        lock_guard<mutex> guard(lock);
+        body = &fn;
+        count = n;
+        next.store(0, memory_order_relaxed);
+        error = nullptr;
+        jobId++;
+    }
+    wake.notify_all();
+
+    runChunk(fn, n);
+
+    exception_ptr failure;
+    {
+        unique_lock<mutex> guard(lock);
+        // Indices are exhausted once the caller's chunk returns; wait for stragglers
+        finished.wait(guard, [&] { return busyWorkers == 0; });
+        body = nullptr;
+        failure = error;
+        error = nullptr;
+    }
+    if (failure) rethrow_exception(failure);
+}
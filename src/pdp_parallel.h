@@ -0,0 +1,66 @@
+#ifndef PDP_PARALLEL_H
+#define PDP_PARALLEL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+#include <cstddef>
+
+/**
+ * @brief Fixed-size pool of worker threads for data-parallel loops.
+ *
+ * parallelFor(count, body) runs body(i) for every i in [0, count) and returns
+ * when all calls are done. The calling thread takes part, so a pool of size N
+ * starts N - 1 workers, and size 1 runs everything inline with no threads.
+ * Indices are handed out dynamically (uneven decode times balance themselves).
+ * Callers write results into per-index slots and reduce them serially afterwards,
+ * which keeps results identical to a serial loop.
+ *
+ * body must be safe to run concurrently (e.g. decode with the thread_local
+ * workspace, look up through the thread-safe SolutionCache). The first exception
+ * thrown by body is rethrown from parallelFor after the loop drains.
+ *
+ * parallelFor must not be called concurrently on the same pool, nor from inside body.
+ */
+class ThreadPool {
+public:
+    /**
+     * @param numThreads Total threads including the caller (0 = hardware_concurrency)
+     */
+    explicit ThreadPool(int numThreads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Threads taking part in parallelFor (workers + caller)
+    int size() const { return (int)workers.size() + 1; }
+
+    void parallelFor(size_t count, const std::function<void(size_t)>& body);
+
+    // Resolve a thread-count setting: 0 = hardware_concurrency (at least 1)
+    static int resolveThreadCount(int requested);
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex lock;
+    std::condition_variable wake;      // workers: new job or shutdown
+    std::condition_variable finished;  // caller: all workers left the job
+
+    const std::function<void(size_t)>* body = nullptr;
+    size_t count = 0;
+    std::atomic<size_t> next{0};
+    unsigned long long jobId = 0;
+    int busyWorkers = 0;
+    bool stopping = false;
+    std::exception_ptr error;
+
+    void workerLoop();
+    void runChunk(const std::function<void(size_t)>& fn, size_t n);
+};
+
+#endif // PDP_PARALLEL_H
@@ -5,6 +5,8 @@
 #include <sstream>
 #include <map>
 #include <cmath>
+#include <algorithm>
+#include <limits>
 
 using namespace std;
 
@@ -14,8 +16,8 @@ double manhattanDistance(double x1, double y1, double x2, double y2) {
 
 void buildAllDistanceMatrices(PDPData& data) {
     int n = data.numNodes;
-    data.truckDistMatrix.assign(n, vector<double>(n, 0.0));
-    data.droneDistMatrix.assign(n, vector<double>(n, 0.0));
+    vector<int32_t> truckCells((size_t)n * n, 0);
+    vector<int32_t> droneCells((size_t)n * n, 0);
 
     for (int i = 0; i < n; ++i) {
         for (int j = i + 1; j < n; ++j) {
@@ -24,23 +26,120 @@ void buildAllDistanceMatrices(PDPData& data) {
             
             // 1. Drone: Euclidean distance -> time in minutes (rounded)
             double eu_dist = euclideanDistance(c1.first, c1.second, c2.first, c2.second);
-            double time_drone = round((eu_dist / data.droneSpeed) * 60.0);
-            data.droneDistMatrix[i][j] = time_drone;
-            data.droneDistMatrix[j][i] = time_drone;
+            int32_t time_drone = (int32_t)lround((eu_dist / data.droneSpeed) * 60.0);
+            droneCells[(size_t)i * n + j] = time_drone;
+            droneCells[(size_t)j * n + i] = time_drone;
             
             // 2. Truck: Manhattan distance -> time in minutes (rounded)
             double mh_dist = manhattanDistance(c1.first, c1.second, c2.first, c2.second);
-            double time_truck = round((mh_dist / data.truckSpeed) * 60.0);
-            data.truckDistMatrix[i][j] = time_truck;
-            data.truckDistMatrix[j][i] = time_truck;
+            int32_t time_truck = (int32_t)lround((mh_dist / data.truckSpeed) * 60.0);
+            truckCells[(size_t)i * n + j] = time_truck;
+            truckCells[(size_t)j * n + i] = time_truck;
         }
     }
+    data.truckDistMatrix.assign(n, truckCells);
+    data.droneDistMatrix.assign(n, droneCells);
     cout << "Truck (Manhattan->time) and Drone (Euclidean->time) matrices built (minutes, rounded)." << endl;
 }
 
+void buildNeighborLists(PDPData& data, int k) {
+    int n = data.numNodes;
+    data.neighborStart.clear();
+    data.neighborList.clear();
+    data.neighborK = 0;
+    if (k <= 0 || n <= 1) return;
+
+    data.neighborK = k;
+    vector<vector<int>> adj(n);  // Symmetric: j listed by i goes into both lists
+    vector<int> others;
+    others.reserve(n);
+    vector<int> listedBy(n, -1);  // listedBy[j] == i: j already in i's list
+    for (int i = 0; i < n; ++i) {
+        for (const TravelTimeMatrix* m : {&data.truckDistMatrix, &data.droneDistMatrix}) {
+            others.clear();
+            for (int j = 0; j < n; ++j) {
+                if (j != i && j != data.depotIndex) others.push_back(j);
+            }
+            int take = min(k, (int)others.size());
+            partial_sort(others.begin(), others.begin() + take, others.end(), [&](int a, int b) {
+                int da = m->at(i, a), db = m->at(i, b);
+                return da < db || (da == db && a < b);
+            });
+            for (int t = 0; t < take; ++t) {
+                int j = others[t];
+                if (listedBy[j] == i) continue;
+                listedBy[j] = i;
+                adj[i].push_back(j);
+                adj[j].push_back(i);
+            }
+        }
+    }
+    data.neighborStart.assign(n + 1, 0);
+    for (int i = 0; i < n; ++i) {
+        sort(adj[i].begin(), adj[i].end());
+        adj[i].erase(unique(adj[i].begin(), adj[i].end()), adj[i].end());
+        data.neighborStart[i] = (int)data.neighborList.size();
+        data.neighborList.insert(data.neighborList.end(), adj[i].begin(), adj[i].end());
+    }
+    data.neighborStart[n] = (int)data.neighborList.size();
+}
+
 
 // === H├ÇM ─Éß╗îC FILE CH├ìNH ===
 
+void buildNodeAttributes(PDPData& data) {
+    int n = data.numNodes;
+    data.nodeKind.assign(n, NODE_DEPOT);
+    data.customerFlag.assign(n, 0);
+    data.droneEligibleFlag.assign(n, 0);
+    data.droneReachableFlag.assign(n, 1);
+    data.truckNearestTime.assign(n, 0.0);
+    data.pairPartner.assign(n, -1);
+
+    map<int, int> pickupOfPair, deliveryOfPair;
+    for (int i = 0; i < n; ++i) {
+        const string& t = data.nodeTypes[i];
+        if (t == "P") data.nodeKind[i] = NODE_P;
+        else if (t == "DL") data.nodeKind[i] = NODE_DL;
+        else if (t == "D" && data.readyTimes[i] > 0) data.nodeKind[i] = NODE_D;
+
+        data.droneEligibleFlag[i] = (data.nodeKind[i] == NODE_D);
+        data.customerFlag[i] = (i != data.depotIndex && data.nodeKind[i] != NODE_DEPOT);
+
+        int pid = data.pairIds[i];
+        if (pid > 0) {
+            if (data.nodeKind[i] == NODE_P && !pickupOfPair.count(pid)) pickupOfPair[pid] = i;
+            if (data.nodeKind[i] == NODE_DL && !deliveryOfPair.count(pid)) deliveryOfPair[pid] = i;
+        }
+    }
+    for (const auto& pd : pickupOfPair) {
+        auto it = deliveryOfPair.find(pd.first);
+        if (it == deliveryOfPair.end()) continue;
+        data.pairPartner[pd.second] = it->second;
+        data.pairPartner[it->second] = pd.second;
+    }
+
+    // Flight time as the decoder computes it, with no wait at the rendezvous
+    if (data.droneDistMatrix.size() == n && data.depotIndex >= 0 && data.depotIndex < n) {
+        for (int i = 0; i < n; ++i) {
+            double t_fly = data.droneDistMatrix(data.depotIndex, i) / data.droneSpeed * 60.0;
+            double t_return = data.droneDistMatrix(i, data.depotIndex) / data.droneSpeed * 60.0;
+            data.droneReachableFlag[i] = (t_fly + t_return <= data.droneEndurance);
+        }
+    }
+
+    // Travel time as the decoder computes it (the matrix is symmetric: in = out)
+    if (data.truckDistMatrix.size() == n && n > 1) {
+        for (int i = 0; i < n; ++i) {
+            double best = numeric_limits<double>::infinity();
+            for (int j = 0; j < n; ++j) {
+                if (j != i) best = min(best, data.truckDistMatrix(j, i) / data.truckSpeed * 60.0);
+            }
+            data.truckNearestTime[i] = best;
+        }
+    }
+}
+
 bool readPDPFile(const string& filename, PDPData& data) {
     ifstream file(filename);
     if (!file.is_open()) {
@@ -117,6 +216,7 @@ bool readPDPFile(const string& filename, PDPData& data) {
     
     // B╞»ß╗ÜC 3: X├éY Dß╗░NG MA TRß║¼N KHOß║óNG C├üCH
     buildAllDistanceMatrices(data);
+    buildNodeAttributes(data);
 
     data.numCustomers = 0;
     for(int i=1; i < data.numNodes; ++i) {
@@ -50,4 +50,23 @@ void showPDPInfo(const PDPData& data);
  */
 void buildAllDistanceMatrices(PDPData& data); 
 
+/**
+ * @brief Derive the compact node arrays (nodeKind, customerFlag, droneEligibleFlag,
+ * pairPartner) from nodeTypes / readyTimes / pairIds, and droneReachableFlag /
+ * truckNearestTime from the distance matrices (all 1 / 0 if they are not built yet).
+ * Must be called again whenever those vectors, depotIndex or the drone parameters change.
+ * @param[out] data PDPData with node attributes populated
+ */
+void buildNodeAttributes(PDPData& data);
+
+/**
+ * @brief Build the k-nearest-neighbor candidate lists used to restrict the tabu
+ * (swap, 2-opt, Or-opt) and truck LS (2-opt, swap, relocate) neighborhoods.
+ * Each node picks its k nearest nodes by truck time and its k nearest by drone
+ * time (depot excluded, ties by index); two nodes are candidates of each other if
+ * either picked the other. k <= 0 turns the restriction off.
+ * @param[out] data PDPData with distance matrices built
+ */
+void buildNeighborLists(PDPData& data, int k);
+
 #endif
@@ -10,21 +10,64 @@
 
 using namespace std;
 
-// ============ TABU MOVE ============
+// ============ TABU LIST ============
 
-string TabuMove::key() const {
-    return to_string(type) + "_" + to_string(i) + "_" + to_string(j) + "_" + to_string(param);
+void TabuList::reset(int tenure) {
+    size_t cap = 64;
+    while (cap < 4 * (size_t)(max(tenure, 0) + 1)) cap <<= 1;
+    slots.assign(cap, Slot());
+    mask = cap - 1;
+    used = 0;
+}
+
+void TabuList::place(uint64_t key, int expiry) {
+    size_t s = home(key);
+    while (slots[s].key != 0 && slots[s].key != key) s = (s + 1) & mask;
+    if (slots[s].key == 0) used++;
+    slots[s].key = key;
+    slots[s].expiry = expiry;
+}
+
+// Rebuild with the live entries only; grow if they alone fill half the table
+void TabuList::purge(int currentIter) {
+    vector<Slot> live;
+    for (const Slot& slot : slots) {
+        if (slot.key != 0 && currentIter < slot.expiry) live.push_back(slot);
+    }
+    size_t cap = slots.size();
+    while (live.size() * 2 >= cap) cap <<= 1;
+    slots.assign(cap, Slot());
+    mask = cap - 1;
+    used = 0;
+    for (const Slot& slot : live) place(slot.key, slot.expiry);
+}
+
+void TabuList::add(uint64_t key, int expiry, int currentIter) {
+    if (slots.empty()) reset(0);
+    place(key, expiry);
+    if (used * 2 > slots.size()) purge(currentIter);
+}
+
+bool TabuList::isTabu(uint64_t key, int currentIter) const {
+    if (slots.empty()) return false;
+    for (size_t s = home(key); slots[s].key != 0; s = (s + 1) & mask) {
+        if (slots[s].key == key) return currentIter < slots[s].expiry;
+    }
+    return false;
 }
 
 // ============ TABU SEARCH CLASS ============
 
-TabuSearchPDP::TabuSearchPDP(const PDPData& data, int maxIterations, SolutionCache& cache)
-    : data(data), maxIterations(maxIterations), cache(cache) {
+TabuSearchPDP::TabuSearchPDP(const PDPData& data, int maxIterations, SolutionCache& cache,
+                             unsigned seed, ThreadPool* pool, const Deadline& deadline, ostream& log)
+    : data(data), maxIterations(maxIterations), cache(cache), pool(pool), deadline(deadline),
+      rng(seed), log(log) {
     int n = data.numCustomers;
     double k = 0.2;  // 20% of customers
     int r = 10;      // random range
     
-    tabuTenure = (int)(k * n) + (rand() % (r + 1));
+    tabuTenure = (int)(k * n) + uniform_int_distribution<int>(0, r)(rng);
+    tabuList.reset(tabuTenure);
     
     // Initialize 6 moves with equal weights
     weights = vector<double>(6, 1.0);
@@ -34,7 +77,7 @@ TabuSearchPDP::TabuSearchPDP(const PDPData& data, int maxIterations, SolutionCac
 
 int TabuSearchPDP::selectMoveIndex() {
     double totalWeight = accumulate(weights.begin(), weights.end(), 0.0);
-    double rnd = ((double)rand() / RAND_MAX) * totalWeight;
+    double rnd = uniform_real_distribution<double>(0.0, totalWeight)(rng);
     double acc = 0.0;
     
     for (int i = 0; i < (int)weights.size(); ++i) {
@@ -59,314 +102,259 @@ void TabuSearchPDP::updateWeights(int segmentLength) {
 }
 
 void TabuSearchPDP::addTabu(const TabuMove& move, int currentIter) {
-    tabuList[move.key()] = currentIter + tabuTenure;
+    tabuList.add(move.key(), currentIter + tabuTenure, currentIter);
 }
 
 bool TabuSearchPDP::isTabu(const TabuMove& move, int currentIter) const {
-    auto it = tabuList.find(move.key());
-    if (it != tabuList.end() && currentIter < it->second) {
-        return true;
-    }
-    return false;
+    return tabuList.isTabu(move.key(), currentIter);
 }
 
-Chromosome TabuSearchPDP::applyMove(const Chromosome& chromo, const TabuMove& move) const {
-    Chromosome result = chromo;
-    int n = (int)result.sequence.size();
-    if ((int)result.truck_assign.size() != n) result.truck_assign.assign(n, 0);
-    if ((int)result.drone_assign.size() != n) result.drone_assign.assign(n, 0);
-    if ((int)result.break_bit.size() != n) result.break_bit.assign(n, 1);
-
-    auto eraseInsert = [&](vector<int>& v, int from, int to) {
-        int temp = v[from];
-        v.erase(v.begin() + from);
-        v.insert(v.begin() + to, temp);
-    };
-
-    auto reverseSeg = [&](vector<int>& v, int i, int j) {
-        reverse(v.begin() + i, v.begin() + j + 1);
-    };
+// Move the block [from, from + len) so that it starts at `to` (the others shift)
+static void moveBlock(vector<int>& v, int from, int len, int to) {
+    if (to > from) {
+        rotate(v.begin() + from, v.begin() + from + len, v.begin() + to + len);
+    } else if (to < from) {
+        rotate(v.begin() + to, v.begin() + from, v.begin() + from + len);
+    }
+}
 
-    auto relocateBlock = [&](vector<int>& v, int start, int blockSize, int target) {
-        if (start + blockSize > (int)v.size()) return;
-        vector<int> block(v.begin() + start, v.begin() + start + blockSize);
-        v.erase(v.begin() + start, v.begin() + start + blockSize);
-        int insertPos = target;
-        if (target > start) insertPos -= blockSize;
-        insertPos = max(0, min(insertPos, (int)v.size()));
-        v.insert(v.begin() + insertPos, block.begin(), block.end());
-    };
+void TabuSearchPDP::applyMove(Chromosome& chromo, const TabuMove& move, bool undo) const {
+    int n = (int)chromo.sequence.size();
 
-    auto relocatePair = [&](vector<int>& v, int start, int target) {
-        if (start + 1 >= (int)v.size()) return;
-        int a = v[start];
-        int b = v[start + 1];
-        v.erase(v.begin() + start, v.begin() + start + 2);
-        int insertPos = target;
-        if (target > start) insertPos -= 2;
-        insertPos = max(0, min(insertPos, (int)v.size()));
-        v.insert(v.begin() + insertPos, a);
-        v.insert(v.begin() + insertPos + 1, b);
-    };
-    
-    switch (move.type) {
-        case 0: // Swap
-            swap(result.sequence[move.i], result.sequence[move.j]);
-            swap(result.truck_assign[move.i], result.truck_assign[move.j]);
-            swap(result.drone_assign[move.i], result.drone_assign[move.j]);
-            swap(result.break_bit[move.i], result.break_bit[move.j]);
-            break;
-            
-        case 1: { // Insert
-            eraseInsert(result.sequence, move.i, move.j);
-            eraseInsert(result.truck_assign, move.i, move.j);
-            eraseInsert(result.drone_assign, move.i, move.j);
-            eraseInsert(result.break_bit, move.i, move.j);
-            break;
+    if (move.type == 0) { // Swap
+        chromo.toggleFingerprintRange(move.i, move.i);
+        chromo.toggleFingerprintRange(move.j, move.j);
+        for (int f = 0; f < 4; ++f) {
+            vector<int>& v = chromo.field(f);
+            swap(v[move.i], v[move.j]);
         }
-        
-        case 2: { // 2-opt (reverse segment)
-            reverseSeg(result.sequence, move.i, move.j);
-            reverseSeg(result.truck_assign, move.i, move.j);
-            reverseSeg(result.drone_assign, move.i, move.j);
-            reverseSeg(result.break_bit, move.i, move.j);
-            break;
+        chromo.toggleFingerprintRange(move.i, move.i);
+        chromo.toggleFingerprintRange(move.j, move.j);
+        return;
+    }
+
+    if (move.type == 2 || move.type == 3) { // 2-opt / 2-opt* (reverse segment)
+        if (move.i >= move.j) return;
+        chromo.toggleFingerprintRange(move.i, move.j);
+        for (int f = 0; f < 4; ++f) {
+            vector<int>& v = chromo.field(f);
+            reverse(v.begin() + move.i, v.begin() + move.j + 1);
         }
-        
-        case 3: { // 2-opt* (reverse segment between i and j)
-            if (move.i < move.j) {
-                reverseSeg(result.sequence, move.i, move.j);
-                reverseSeg(result.truck_assign, move.i, move.j);
-                reverseSeg(result.drone_assign, move.i, move.j);
-                reverseSeg(result.break_bit, move.i, move.j);
+        chromo.toggleFingerprintRange(move.i, move.j);
+        return;
+    }
+
+    // Insert (1), Or-opt (4) and relocate-pair (5) take the block at i out and put
+    // it back in at j of the shortened sequence
+    int len = (move.type == 1) ? 1 : (move.type == 4) ? move.param : 2;
+    if (move.i + len > n) return;
+    int to = move.j;
+    if (move.type != 1) {
+        if (move.j > move.i) to -= len;
+        to = max(0, min(to, n - len));
+    }
+    int from = move.i;
+    if (undo) swap(from, to);
+
+    int lo = min(from, to), hi = max(from, to) + len - 1;
+    chromo.toggleFingerprintRange(lo, hi);
+    for (int f = 0; f < 4; ++f) {
+        moveBlock(chromo.field(f), from, len, to);
+    }
+    chromo.toggleFingerprintRange(lo, hi);
+}
+
+// ============ MOVE GENERATION FUNCTIONS ============
+// Each findBest*Move lists its candidate moves; selectBestMove evaluates them and
+// keeps the best admissible one.
+
+bool TabuSearchPDP::selectBestMove(const Chromosome& current, double currentCost,
+                                   double bestCost, int iter, TabuMove& bestMove,
+                                   double& bestDelta) {
+    size_t count = scanMoves.size();
+    scanCost.resize(count);
+
+    // Candidate costs are independent: the list is cut into chunks (several per
+    // thread when there is a pool), and each chunk applies and undoes its moves on
+    // one private copy of `current`. Each cost slot is written by one thread only.
+    //
+    // A candidate costing more than an admissible one earlier in its chunk (or than
+    // the best delta already found) can never be chosen below, so its decode stops
+    // as soon as that is certain and its slot is left at +inf.
+    size_t chunks = pool ? min(count, (size_t)pool->size() * 4) : min(count, (size_t)1);
+    if (scanWork.size() < chunks) scanWork.resize(chunks);
+    auto evaluateChunk = [&](size_t c) {
+        Chromosome& work = scanWork[c];
+        work = current;
+        double bound = currentCost + bestDelta;
+        for (size_t k = count * c / chunks; k < count * (c + 1) / chunks; ++k) {
+            applyMove(work, scanMoves[k]);
+            bool pruned = false;
+            PDPCost candidateSol = evaluateCostWithCache(work, data, cache, checkpoints, bound, pruned);
+            applyMove(work, scanMoves[k], true);
+            if (pruned) {
+                scanCost[k] = numeric_limits<double>::infinity();
+                continue;
             }
-            break;
-        }
-        
-        case 4: { // Or-opt (relocate block)
-            int blockSize = move.param;
-            relocateBlock(result.sequence, move.i, blockSize, move.j);
-            relocateBlock(result.truck_assign, move.i, blockSize, move.j);
-            relocateBlock(result.drone_assign, move.i, blockSize, move.j);
-            relocateBlock(result.break_bit, move.i, blockSize, move.j);
-            break;
+            scanCost[k] = candidateSol.totalCost + candidateSol.totalPenalty;
+            if (scanCost[k] < bound && (!isTabu(scanMoves[k], iter) || scanCost[k] < bestCost))
+                bound = scanCost[k];
         }
-        
-        case 5: { // Relocate pair
-            relocatePair(result.sequence, move.i, move.j);
-            relocatePair(result.truck_assign, move.i, move.j);
-            relocatePair(result.drone_assign, move.i, move.j);
-            relocatePair(result.break_bit, move.i, move.j);
-            break;
+    };
+    if (pool) {
+        pool->parallelFor(chunks, evaluateChunk);
+    } else {
+        for (size_t c = 0; c < chunks; ++c) evaluateChunk(c);
+    }
+
+    // Reduce in list order, so the chosen move (ties included) is the one a serial
+    // scan would pick, whatever the thread count.
+    bool found = false;
+    for (size_t k = 0; k < count; ++k) {
+        const TabuMove& move = scanMoves[k];
+        double candidateCost = scanCost[k];
+        double delta = candidateCost - currentCost;
+
+        // Aspiration criterion: accept tabu if better than best
+        if (!isTabu(move, iter) || candidateCost < bestCost) {
+            if (delta < bestDelta) {
+                bestDelta = delta;
+                bestMove = move;
+                found = true;
+            }
         }
     }
-    
-    return result;
+
+    return found;
 }
 
-// ============ MOVE GENERATION FUNCTIONS ============
+void TabuSearchPDP::indexGranular(const vector<int>& seq) {
+    granularRoute.assign(1, data.depotIndex);
+    granularRoute.insert(granularRoute.end(), seq.begin(), seq.end());
+    granular.build(data, granularRoute);
+}
 
 bool TabuSearchPDP::findBestSwapMove(const Chromosome& current, double currentCost,
                                      double bestCost, int iter, TabuMove& bestMove,
-                                     Chromosome& bestCandidate, double& bestDelta) {
-    bool found = false;
-    
-    for (int i = 0; i < (int)current.sequence.size(); ++i) {
-        for (int j = i + 1; j < (int)current.sequence.size(); ++j) {
-            TabuMove move{0, i, j, 0};
-            
-            bool isTabuMove = isTabu(move, iter);
-            
-            Chromosome candidate = applyMove(current, move);
-            PDPSolution candidateSol = evaluateWithCache(candidate, data, cache);
-            double candidateCost = candidateSol.totalCost + candidateSol.totalPenalty;
-            double delta = candidateCost - currentCost;
-            
-            // Aspiration criterion: accept tabu if better than best
-            if (!isTabuMove || candidateCost < bestCost) {
-                if (delta < bestDelta) {
-                    bestDelta = delta;
-                    bestMove = move;
-                    bestCandidate = candidate;
-                    found = true;
-                }
-            }
+                                     double& bestDelta) {
+    // Granular: only swap customers that are in each other's candidate lists
+    const vector<int>& seq = current.sequence;
+    int n = (int)seq.size();
+    indexGranular(seq);
+    scanMoves.clear();
+    for (int i = 0; i < n; ++i) {
+        granular.candidates(seq[i], i + 2, n + 1, scanPos);
+        for (int p : scanPos) {
+            scanMoves.push_back(TabuMove{0, i, p - 1, 0});
         }
     }
     
-    return found;
+    return selectBestMove(current, currentCost, bestCost, iter, bestMove, bestDelta);
 }
 
 bool TabuSearchPDP::findBestInsertMove(const Chromosome& current, double currentCost,
                                        double bestCost, int iter, TabuMove& bestMove,
-                                       Chromosome& bestCandidate, double& bestDelta) {
-    bool found = false;
+                                       double& bestDelta) {
     int n = (int)current.sequence.size();
     
     // Limit search for large instances
     int maxTrials = min(50, n * n / 4);
-    random_device rd;
-    mt19937 gen(rd());
     uniform_int_distribution<> dist(0, n - 1);
     
+    // Trials are drawn up front so the sample does not depend on evaluation order
+    scanMoves.clear();
     for (int trial = 0; trial < maxTrials; ++trial) {
-        int i = dist(gen);
-        int j = dist(gen);
+        int i = dist(rng);
+        int j = dist(rng);
         
         if (i == j) continue;
         
-        TabuMove move{1, i, j, 0};
-        bool isTabuMove = isTabu(move, iter);
-        
-        Chromosome candidate = applyMove(current, move);
-        PDPSolution candidateSol = evaluateWithCache(candidate, data, cache);
-        double candidateCost = candidateSol.totalCost + candidateSol.totalPenalty;
-        double delta = candidateCost - currentCost;
-        
-        if (!isTabuMove || candidateCost < bestCost) {
-            if (delta < bestDelta) {
-                bestDelta = delta;
-                bestMove = move;
-                bestCandidate = candidate;
-                found = true;
-            }
-        }
+        scanMoves.push_back(TabuMove{1, i, j, 0});
     }
     
-    return found;
+    return selectBestMove(current, currentCost, bestCost, iter, bestMove, bestDelta);
 }
 
 bool TabuSearchPDP::findBest2OptMove(const Chromosome& current, double currentCost,
                                      double bestCost, int iter, TabuMove& bestMove,
-                                     Chromosome& bestCandidate, double& bestDelta) {
-    bool found = false;
+                                     double& bestDelta) {
     int n = (int)current.sequence.size();
     
-    // Try 2-opt on segments
+    // Try 2-opt on segments. Granular: the reversal must join seq[i - 1] (or the
+    // depot) to a candidate-list neighbor seq[j].
+    indexGranular(current.sequence);
+    scanMoves.clear();
     for (int i = 0; i < n - 1; ++i) {
-        for (int j = i + 1; j < min(n, i + 20); ++j) { // Limit segment size
-            TabuMove move{2, i, j, 0};
-            bool isTabuMove = isTabu(move, iter);
-            
-            Chromosome candidate = applyMove(current, move);
-            PDPSolution candidateSol = evaluateWithCache(candidate, data, cache);
-            double candidateCost = candidateSol.totalCost + candidateSol.totalPenalty;
-            double delta = candidateCost - currentCost;
-            
-            if (!isTabuMove || candidateCost < bestCost) {
-                if (delta < bestDelta) {
-                    bestDelta = delta;
-                    bestMove = move;
-                    bestCandidate = candidate;
-                    found = true;
-                }
-            }
+        // Limit segment size: j < i + 20
+        granular.candidates(granularRoute[i], i + 2, min(n, i + 20) + 1, scanPos);
+        for (int p : scanPos) {
+            scanMoves.push_back(TabuMove{2, i, p - 1, 0});
         }
     }
     
-    return found;
+    return selectBestMove(current, currentCost, bestCost, iter, bestMove, bestDelta);
 }
 
 bool TabuSearchPDP::findBest2OptStarMove(const Chromosome& current, double currentCost,
                                          double bestCost, int iter, TabuMove& bestMove,
-                                         Chromosome& bestCandidate, double& bestDelta) {
-    bool found = false;
+                                         double& bestDelta) {
     int n = (int)current.sequence.size();
     
     // Similar to 2-opt but different reversal strategy
+    scanMoves.clear();
     for (int i = 0; i < n - 2; ++i) {
         for (int j = i + 2; j < min(n, i + 15); ++j) {
-            TabuMove move{3, i, j, 0};
-            bool isTabuMove = isTabu(move, iter);
-            
-            Chromosome candidate = applyMove(current, move);
-            PDPSolution candidateSol = evaluateWithCache(candidate, data, cache);
-            double candidateCost = candidateSol.totalCost + candidateSol.totalPenalty;
-            double delta = candidateCost - currentCost;
-            
-            if (!isTabuMove || candidateCost < bestCost) {
-                if (delta < bestDelta) {
-                    bestDelta = delta;
-                    bestMove = move;
-                    bestCandidate = candidate;
-                    found = true;
-                }
-            }
+            scanMoves.push_back(TabuMove{3, i, j, 0});
         }
     }
     
-    return found;
+    return selectBestMove(current, currentCost, bestCost, iter, bestMove, bestDelta);
 }
 
 bool TabuSearchPDP::findBestOrOptMove(const Chromosome& current, double currentCost,
                                       double bestCost, int iter, TabuMove& bestMove,
-                                      Chromosome& bestCandidate, double& bestDelta) {
-    bool found = false;
+                                      double& bestDelta) {
     int n = (int)current.sequence.size();
     
-    // Try block sizes 1, 2, 3
+    // Try block sizes 1, 2, 3. Granular: the block head must land right after a
+    // candidate-list neighbor (seq[j - 1], or the depot at the front).
+    const vector<int>& seq = current.sequence;
+    indexGranular(seq);
+    scanMoves.clear();
     for (int blockSize = 1; blockSize <= 3; ++blockSize) {
         if (n < blockSize + 1) continue;
         
         for (int i = 0; i <= n - blockSize; ++i) {
-            for (int j = 0; j <= n - blockSize; ++j) {
+            // Position j holds the node the block would follow
+            granular.candidates(seq[i], 0, n - blockSize + 1, scanPos);
+            for (int j : scanPos) {
                 if (abs(i - j) < blockSize) continue; // Skip overlapping
                 
-                TabuMove move{4, i, j, blockSize};
-                bool isTabuMove = isTabu(move, iter);
-                
-                Chromosome candidate = applyMove(current, move);
-                PDPSolution candidateSol = evaluateWithCache(candidate, data, cache);
-                double candidateCost = candidateSol.totalCost + candidateSol.totalPenalty;
-                double delta = candidateCost - currentCost;
-                
-                if (!isTabuMove || candidateCost < bestCost) {
-                    if (delta < bestDelta) {
-                        bestDelta = delta;
-                        bestMove = move;
-                        bestCandidate = candidate;
-                        found = true;
-                    }
-                }
+                scanMoves.push_back(TabuMove{4, i, j, blockSize});
             }
         }
     }
     
-    return found;
+    return selectBestMove(current, currentCost, bestCost, iter, bestMove, bestDelta);
 }
 
 bool TabuSearchPDP::findBestRelocatePairMove(const Chromosome& current, double currentCost,
                                              double bestCost, int iter, TabuMove& bestMove,
-                                             Chromosome& bestCandidate, double& bestDelta) {
-    bool found = false;
+                                             double& bestDelta) {
     int n = (int)current.sequence.size();
     
     if (n < 3) return false;
     
+    scanMoves.clear();
     for (int i = 0; i < n - 1; ++i) {
         for (int j = 0; j <= n - 2; ++j) {
             if (abs(i - j) < 2) continue; // Skip overlapping
             
-            TabuMove move{5, i, j, 0};
-            bool isTabuMove = isTabu(move, iter);
-            
-            Chromosome candidate = applyMove(current, move);
-            PDPSolution candidateSol = evaluateWithCache(candidate, data, cache);
-            double candidateCost = candidateSol.totalCost + candidateSol.totalPenalty;
-            double delta = candidateCost - currentCost;
-            
-            if (!isTabuMove || candidateCost < bestCost) {
-                if (delta < bestDelta) {
-                    bestDelta = delta;
-                    bestMove = move;
-                    bestCandidate = candidate;
-                    found = true;
-                }
-            }
+            scanMoves.push_back(TabuMove{5, i, j, 0});
         }
     }
     
-    return found;
+    return selectBestMove(current, currentCost, bestCost, iter, bestMove, bestDelta);
 }
 
 // ============ MAIN TABU SEARCH ============
@@ -380,11 +368,14 @@ Chromosome TabuSearchPDP::run(const Chromosome& initial) {
     if ((int)current.truck_assign.size() != n) current.truck_assign.assign(n, 0);
     if ((int)current.drone_assign.size() != n) current.drone_assign.assign(n, 0);
     if ((int)current.break_bit.size() != n) current.break_bit.assign(n, 1);
+    // Neighbors inherit the fingerprint and update it per move (O(1) cache hashing)
+    current.refreshFingerprint();
 
     best = current;
 
-    PDPSolution currentSol = evaluateWithCache(current, data, cache);
-    PDPSolution bestSol = currentSol;
+    // Only costs are needed here; the caller decodes the returned chromosome in full.
+    // Neighbors of `current` are decoded from its prefix checkpoints.
+    PDPCost currentSol = buildDecoderCheckpoints(current, data, checkpoints);
     double currentCost = currentSol.totalCost + currentSol.totalPenalty;
     double bestCost = currentCost;
     
@@ -398,7 +389,6 @@ Chromosome TabuSearchPDP::run(const Chromosome& initial) {
         int moveIndex = selectMoveIndex();
         
         TabuMove bestMove{-1, -1, -1, 0};
-        Chromosome bestCandidate;
         double bestDelta = numeric_limits<double>::infinity();
         bool moveFound = false;
         
@@ -406,45 +396,43 @@ Chromosome TabuSearchPDP::run(const Chromosome& initial) {
         switch (moveIndex) {
             case 0:
                 moveFound = findBestSwapMove(current, currentCost, bestCost, iter,
-                                            bestMove, bestCandidate, bestDelta);
+                                            bestMove, bestDelta);
                 break;
             case 1:
                 moveFound = findBestInsertMove(current, currentCost, bestCost, iter,
-                                              bestMove, bestCandidate, bestDelta);
+                                              bestMove, bestDelta);
                 break;
             case 2:
                 moveFound = findBest2OptMove(current, currentCost, bestCost, iter,
-                                            bestMove, bestCandidate, bestDelta);
+                                            bestMove, bestDelta);
                 break;
             case 3:
                 moveFound = findBest2OptStarMove(current, currentCost, bestCost, iter,
-                                                bestMove, bestCandidate, bestDelta);
+                                                bestMove, bestDelta);
                 break;
             case 4:
                 moveFound = findBestOrOptMove(current, currentCost, bestCost, iter,
-                                             bestMove, bestCandidate, bestDelta);
+                                             bestMove, bestDelta);
                 break;
             case 5:
                 moveFound = findBestRelocatePairMove(current, currentCost, bestCost, iter,
-                                                     bestMove, bestCandidate, bestDelta);
+                                                     bestMove, bestDelta);
                 break;
         }
         
         // Apply best move if found
         if (moveFound && bestMove.type != -1) {
             double previousCost = currentCost;
-            current = bestCandidate;
+            applyMove(current, bestMove);
             
-            PDPSolution newSol = evaluateWithCache(current, data, cache);
+            PDPCost newSol = buildDecoderCheckpoints(current, data, checkpoints);
             currentCost = newSol.totalCost + newSol.totalPenalty;
-            currentSol = newSol;
             
             // Update adaptive weights
             if (currentCost < bestCost) {
                 scores[moveIndex] += delta1; // Best solution found
                 bestCost = currentCost;
                 best = current;
-                bestSol = newSol;
                 noImprovement = 0;
             } else if (currentCost < previousCost) {
                 scores[moveIndex] += delta2; // Improved current
@@ -466,13 +454,13 @@ Chromosome TabuSearchPDP::run(const Chromosome& initial) {
         }
         
         // Early stopping
-        if (noImprovement >= maxNoImprovement) {
+        if (noImprovement >= maxNoImprovement || deadline.expired()) {
             break;
         }
         
         // Progress output
         if (iter % 50 == 0 && iter > 0) {
-            cout << "  Tabu iter " << iter << ": best=" << bestCost 
+            log << "  Tabu iter " << iter << ": best=" << bestCost 
                  << " current=" << currentCost << endl;
         }
     }
@@ -482,7 +470,8 @@ Chromosome TabuSearchPDP::run(const Chromosome& initial) {
 
 
 Chromosome tabuSearchPDP(const Chromosome& initial, const PDPData& data,
-                         int maxIterations, SolutionCache& cache) {
-    TabuSearchPDP tabu(data, maxIterations, cache);
+                         int maxIterations, SolutionCache& cache, unsigned seed,
+                         ThreadPool* pool, const Deadline& deadline, ostream& log) {
+    TabuSearchPDP tabu(data, maxIterations, cache, seed, pool, deadline, log);
     return tabu.run(initial);
 }
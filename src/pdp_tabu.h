@@ -3,9 +3,12 @@
 
 #include "pdp_types.h"
 #include "pdp_cache.h"
+#include "pdp_fitness.h"
+#include "pdp_parallel.h"
 #include <vector>
-#include <string>
-#include <map>
+#include <cstdint>
+#include <random>
+#include <iostream>
 
 // ============ TABU SEARCH WITH ADAPTIVE WEIGHTS & 6 MOVES ============
 
@@ -13,12 +16,50 @@ struct TabuMove {
     int type;  // 0: swap, 1: insert, 2: 2-opt, 3: 2-opt*, 4: Or-opt, 5: relocate-pair
     int i, j;
     int param;  // For block_size (Or-opt) or other parameters
-    std::string key() const;
+
+    // Tabu attribute: type | param | i | j packed into 64 bits (never 0)
+    uint64_t key() const {
+        return ((uint64_t)(type + 1) << 56) | ((uint64_t)(param & 0xFF) << 48) |
+               ((uint64_t)(i & 0xFFFFFF) << 24) | (uint64_t)(j & 0xFFFFFF);
+    }
+};
+
+/**
+ * @brief Tabu list: move key -> iteration the move stops being tabu.
+ *
+ * Open addressing (linear probing) over a power-of-two slot array sized from the
+ * tenure. At most `tenure` moves are tabu at once, so when half the slots are in
+ * use the expired entries are dropped in one pass (amortized O(1)), keeping
+ * probes short. Lookups and inserts do not allocate.
+ */
+class TabuList {
+public:
+    void reset(int tenure);
+    void add(uint64_t key, int expiry, int currentIter);
+    bool isTabu(uint64_t key, int currentIter) const;
+
+private:
+    struct Slot {
+        uint64_t key = 0;   // 0 = empty
+        int expiry = 0;
+    };
+    std::vector<Slot> slots;
+    size_t mask = 0;
+    size_t used = 0;
+
+    size_t home(uint64_t key) const { return (size_t)fingerprintMix(key) & mask; }
+    void place(uint64_t key, int expiry);
+    void purge(int currentIter);
 };
 
 class TabuSearchPDP {
 public:
-    TabuSearchPDP(const PDPData& data, int maxIterations, SolutionCache& cache);
+    // seed: tenure and move-selection RNG. pool: evaluates each neighborhood scan in
+    // parallel (nullptr = serial). run() returns its best so far once deadline expires.
+    // log: progress lines (the island log in an island run).
+    TabuSearchPDP(const PDPData& data, int maxIterations, SolutionCache& cache, unsigned seed,
+                  ThreadPool* pool = nullptr, const Deadline& deadline = Deadline(),
+                  std::ostream& log = std::cout);
     
     // Main tabu search
     Chromosome run(const Chromosome& initial);
@@ -27,8 +68,25 @@ private:
     const PDPData& data;
     int maxIterations;
     int tabuTenure;
-    std::map<std::string, int> tabuList;
+    TabuList tabuList;
     SolutionCache& cache;  // Reference to shared solution cache
+    DecoderCheckpoints checkpoints;  // Prefix snapshots of the current solution
+    ThreadPool* pool;                // Parallel candidate evaluation (nullptr = serial)
+    Deadline deadline;
+    std::mt19937 rng;
+    std::ostream& log;
+
+    // Neighborhood scan scratch: candidate moves and their costs
+    std::vector<TabuMove> scanMoves;
+    std::vector<double> scanCost;
+    std::vector<Chromosome> scanWork;  // One working copy of `current` per scan chunk
+
+    // Granular scans: positions over depot, seq[0], ..., seq[n - 1], so position p
+    // holds seq[p - 1] and the predecessor of seq[p]
+    std::vector<int> granularRoute;
+    GranularIndex granular;
+    std::vector<int> scanPos;
+    void indexGranular(const std::vector<int>& seq);
     
     // Adaptive weights for move selection
     std::vector<double> weights;
@@ -39,43 +97,53 @@ private:
     int selectMoveIndex();
     void updateWeights(int segmentLength);
     
+    // Evaluate scanMoves and keep the best admissible move (deterministic for any pool size)
+    bool selectBestMove(const Chromosome& current, double currentCost,
+                        double bestCost, int iter, TabuMove& bestMove,
+                        double& bestDelta);
+
     // Move generation functions (6 types)
     bool findBestSwapMove(const Chromosome& current, double currentCost,
                          double bestCost, int iter, TabuMove& bestMove,
-                         Chromosome& bestCandidate, double& bestDelta);
+                         double& bestDelta);
     
     bool findBestInsertMove(const Chromosome& current, double currentCost,
                            double bestCost, int iter, TabuMove& bestMove,
-                           Chromosome& bestCandidate, double& bestDelta);
+                           double& bestDelta);
     
     bool findBest2OptMove(const Chromosome& current, double currentCost,
                          double bestCost, int iter, TabuMove& bestMove,
-                         Chromosome& bestCandidate, double& bestDelta);
+                         double& bestDelta);
     
     bool findBest2OptStarMove(const Chromosome& current, double currentCost,
                              double bestCost, int iter, TabuMove& bestMove,
-                             Chromosome& bestCandidate, double& bestDelta);
+                             double& bestDelta);
     
     bool findBestOrOptMove(const Chromosome& current, double currentCost,
                           double bestCost, int iter, TabuMove& bestMove,
-                          Chromosome& bestCandidate, double& bestDelta);
+                          double& bestDelta);
     
     bool findBestRelocatePairMove(const Chromosome& current, double currentCost,
                                  double bestCost, int iter, TabuMove& bestMove,
-                                 Chromosome& bestCandidate, double& bestDelta);
+                                 double& bestDelta);
     
     // Tabu management
     void addTabu(const TabuMove& move, int currentIter);
     bool isTabu(const TabuMove& move, int currentIter) const;
     
-    // Helper: apply move and get candidate
-    Chromosome applyMove(const Chromosome& chromo, const TabuMove& move) const;
+    // Apply a move in place (undo = true reverts the same move), keeping the
+    // fingerprint up to date. Expects the four encoding vectors to be aligned.
+    void applyMove(Chromosome& chromo, const TabuMove& move, bool undo = false) const;
 };
 
 // Simple interface function
 Chromosome tabuSearchPDP(const Chromosome& initial,
                          const PDPData& data,
                          int maxIterations,
-                         SolutionCache& cache);
+                         SolutionCache& cache,
+                         unsigned seed,
+                         ThreadPool* pool = nullptr,
+                         const Deadline& deadline = Deadline(),
+                         std::ostream& log = std::cout);
 
 #endif // PDP_TABU_H
@@ -3,10 +3,60 @@
 
 #include <vector>
 #include <string>
+#include <algorithm>
 #include <utility>
+#include <cstdint>
+#include <chrono>
+#include <type_traits>
 
 using namespace std;
 
+/**
+ * @brief 128-bit position-aware fingerprint of a chromosome.
+ *
+ * Zobrist-style: the XOR of one pseudo-random key per (field, position, value)
+ * gene plus one per field length. Keys are derived by hashing instead of being
+ * stored in a table, so any instance size works. Being an XOR, it is updated in
+ * O(changed genes) when a move edits a chromosome (Chromosome::setGene,
+ * Chromosome::toggleFingerprintRange). Two chromosomes with the same
+ * fingerprint are treated as identical by the compact cache; at 128 bits the
+ * chance of a false match is negligible.
+ */
+struct ChromosomeFingerprint {
+    uint64_t lo = 0;
+    uint64_t hi = 0;
+
+    bool operator==(const ChromosomeFingerprint& other) const {
+        return lo == other.lo && hi == other.hi;
+    }
+};
+
+// Field tags for fingerprintToggle
+enum ChromosomeField : int {
+    FIELD_SEQUENCE = 0,
+    FIELD_TRUCK = 1,
+    FIELD_DRONE = 2,
+    FIELD_BREAK = 3
+};
+
+// splitmix64 finalizer
+inline uint64_t fingerprintMix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief XOR the key of gene (field, pos, value) into `fp` (adds or removes it).
+ * Fields 4..7 are used for the lengths of fields 0..3.
+ */
+inline void fingerprintToggle(ChromosomeFingerprint& fp, int field, int pos, int value) {
+    uint64_t gene = ((uint64_t)field << 60) | ((uint64_t)(pos & 0xFFFFFF) << 32) | (uint32_t)value;
+    fp.lo ^= fingerprintMix(gene ^ 0x5bd1e9955bd1e995ULL);
+    fp.hi ^= fingerprintMix(gene ^ 0xc2b2ae3d27d4eb4fULL);
+}
+
 // Chromosome encoding used by GA/Tabu.
 // sequence: permutation of customer nodes
 // truck_assign: per-position truck assignment (0..numTrucks-1)
@@ -18,12 +68,157 @@ struct Chromosome {
     vector<int> drone_assign;
     vector<int> break_bit;
 
+    // Cached fingerprint, valid while hasFingerprint is set (refreshFingerprint).
+    // setGene / toggleFingerprintRange keep it current; any other edit of the
+    // vectors must be followed by invalidateFingerprint() or refreshFingerprint().
+    ChromosomeFingerprint fp;
+    bool hasFingerprint = false;
+
     bool operator==(const Chromosome& other) const {
+        if (hasFingerprint && other.hasFingerprint && !(fp == other.fp)) return false;
         return sequence == other.sequence &&
                truck_assign == other.truck_assign &&
                drone_assign == other.drone_assign &&
                break_bit == other.break_bit;
     }
+
+    // Gene vector by ChromosomeField tag
+    vector<int>& field(int f) {
+        return f == FIELD_SEQUENCE ? sequence : f == FIELD_TRUCK ? truck_assign
+             : f == FIELD_DRONE ? drone_assign : break_bit;
+    }
+    const vector<int>& field(int f) const {
+        return f == FIELD_SEQUENCE ? sequence : f == FIELD_TRUCK ? truck_assign
+             : f == FIELD_DRONE ? drone_assign : break_bit;
+    }
+
+    // Stored fingerprint if valid, otherwise computed in O(n)
+    ChromosomeFingerprint fingerprint() const;
+    void refreshFingerprint();
+    void invalidateFingerprint() { hasFingerprint = false; }
+
+    // Set one gene, updating the fingerprint in O(1)
+    void setGene(int f, int pos, int value) {
+        vector<int>& v = field(f);
+        if (hasFingerprint) {
+            fingerprintToggle(fp, f, pos, v[pos]);
+            fingerprintToggle(fp, f, pos, value);
+        }
+        v[pos] = value;
+    }
+
+    /**
+     * XOR the genes at positions [lo, hi] of every field out of / into the fingerprint.
+     * Call once before and once after an in-place edit confined to that range that
+     * keeps all vector lengths: O(hi - lo) instead of a full rehash.
+     */
+    void toggleFingerprintRange(int lo, int hi) {
+        if (!hasFingerprint) return;
+        if (lo < 0) lo = 0;
+        for (int f = 0; f < 4; ++f) {
+            const vector<int>& v = field(f);
+            int end = hi < (int)v.size() - 1 ? hi : (int)v.size() - 1;
+            for (int i = lo; i <= end; ++i) {
+                fingerprintToggle(fp, f, i, v[i]);
+            }
+        }
+    }
+};
+
+inline ChromosomeFingerprint fingerprintChromosome(const Chromosome& c) {
+    ChromosomeFingerprint fp;
+    const vector<int>* fields[4] = {&c.sequence, &c.truck_assign, &c.drone_assign, &c.break_bit};
+    for (int f = 0; f < 4; ++f) {
+        const vector<int>& v = *fields[f];
+        fingerprintToggle(fp, f + 4, 0, (int)v.size());
+        for (int i = 0; i < (int)v.size(); ++i) {
+            fingerprintToggle(fp, f, i, v[i]);
+        }
+    }
+    return fp;
+}
+
+inline ChromosomeFingerprint Chromosome::fingerprint() const {
+    return hasFingerprint ? fp : fingerprintChromosome(*this);
+}
+
+inline void Chromosome::refreshFingerprint() {
+    fp = fingerprintChromosome(*this);
+    hasFingerprint = true;
+}
+
+// Compact node classification (PDPData::nodeKind). nodeTypes strings are for I/O only.
+enum NodeKind : uint8_t {
+    NODE_DEPOT = 0,   // "D" with ready time 0 (or any unknown type)
+    NODE_P = 1,       // Pickup (C2)
+    NODE_DL = 2,      // Delivery of a pickup (C2)
+    NODE_D = 3        // Depot-ready delivery (C1), ready time > 0
+};
+
+/**
+ * @brief Square travel-time matrix (whole minutes) stored row-major in one block.
+ *
+ * Entries are kept as int16_t when every value fits and int32_t otherwise, so a
+ * U_100 matrix is ~20KB of contiguous memory instead of 101 separate heap rows.
+ * at() / operator() do no bounds checking and test the width on every call; hot
+ * loops test isNarrow() once and read through view<int16_t>() / view<int32_t>().
+ */
+class TravelTimeMatrix {
+public:
+    /**
+     * @brief Fill from n*n row-major values, picking the narrowest storage that fits.
+     */
+    void assign(int n, const vector<int32_t>& values) {
+        n_ = n;
+        narrow_ = true;
+        for (int32_t v : values) {
+            if (v < INT16_MIN || v > INT16_MAX) { narrow_ = false; break; }
+        }
+        if (narrow_) {
+            cells16_.assign(values.begin(), values.end());
+            cells32_.clear();
+        } else {
+            cells32_ = values;
+            cells16_.clear();
+        }
+    }
+
+    int size() const { return n_; }
+    bool isNarrow() const { return narrow_; }
+    size_t bytes() const { return cells16_.size() * sizeof(int16_t) + cells32_.size() * sizeof(int32_t); }
+
+    int at(int i, int j) const {
+        size_t k = (size_t)i * n_ + j;
+        return narrow_ ? cells16_[k] : cells32_[k];
+    }
+
+    double operator()(int i, int j) const { return at(i, j); }
+
+    // Branch-free accessor over one storage width (only valid for the width in use)
+    template <typename Cell>
+    class View {
+    public:
+        View(const Cell* cells, int n) : cells_(cells), n_(n) {}
+        int at(int i, int j) const { return cells_[(size_t)i * n_ + j]; }
+
+    private:
+        const Cell* cells_;
+        size_t n_;
+    };
+
+    template <typename Cell>
+    View<Cell> view() const {
+        static_assert(std::is_same<Cell, int16_t>::value || std::is_same<Cell, int32_t>::value,
+                      "TravelTimeMatrix stores int16_t or int32_t cells");
+        if constexpr (std::is_same<Cell, int16_t>::value) return View<Cell>(cells16_.data(), n_);
+        else return View<Cell>(cells32_.data(), n_);
+    }
+
+private:
+    int n_ = 0;
+    bool narrow_ = true;
+    vector<int16_t> cells16_;
+    vector<int32_t> cells32_;
 };
 
 /**
@@ -52,6 +247,14 @@ struct PDPData {
     vector<int> readyTimes;                     // Ready time constraints for time-window feasibility
     vector<int> pairIds;                        // Pairing information for pickup-delivery constraints
 
+    // === NODE FLAGS (struct-of-arrays, filled by buildNodeAttributes) ===
+    vector<uint8_t> nodeKind;                   // NodeKind per node
+    vector<uint8_t> customerFlag;               // 1 if isCustomer(node)
+    vector<uint8_t> droneEligibleFlag;          // 1 for "D" nodes with ready time > 0 (drone resupply)
+    vector<uint8_t> droneReachableFlag;         // 1 if the depot -> node -> depot flight fits droneEndurance
+    vector<double> truckNearestTime;            // Shortest truck travel time (decoder minutes) to/from any other node
+    vector<int> pairPartner;                    // P <-> DL partner node with the same pairId, -1 if none
+
     // === DEPOT CONFIGURATION ===
     pair<double, double> depotCenter = {10.0, 10.0};  // Center depot coordinates (primary resupply point)
     pair<double, double> depotBorder = {0.0, 10.0};   // Border depot coordinates (alternative resupply point)
@@ -70,8 +273,14 @@ struct PDPData {
     double depotDroneLoadTime = 5.0;        // Time for drone to load payload at depot (minutes)
 
     // === DISTANCE MATRICES ===
-    vector<vector<double>> truckDistMatrix; // Manhattan distance matrix (truck routing, urban/grid model)
-    vector<vector<double>> droneDistMatrix; // Euclidean distance matrix (drone routing, straight-line model)
+    TravelTimeMatrix truckDistMatrix;       // Manhattan distance matrix (truck routing, urban/grid model)
+    TravelTimeMatrix droneDistMatrix;       // Euclidean distance matrix (drone routing, straight-line model)
+
+    // === GRANULAR NEIGHBORHOODS (filled by buildNeighborLists) ===
+    int neighborK = 0;                      // Candidate list length; 0 = full neighborhoods
+    vector<int> neighborStart;              // Node i's candidates: neighborList[neighborStart[i] .. neighborStart[i + 1])
+    vector<int> neighborList;               // Nodes j with j among i's k nearest (truck or drone time) or i among j's,
+                                            // ascending; symmetric, so walking one endpoint's list finds every pair
 
     // === UTILITY METHODS ===
     
@@ -101,9 +310,26 @@ struct PDPData {
      */
     bool isCustomer(int id) const {
         if (id < 0 || id >= numNodes) return false; 
-        if (id == depotIndex) return false; 
-        string t = nodeTypes[id]; 
-        return (t == "P" || t == "DL" || (t == "D" && readyTimes[id] > 0));
+        return customerFlag[id] != 0;
+    }
+
+    /**
+     * @brief True for "D" nodes with ready time > 0, i.e. nodes a drone may resupply.
+     * @param id 0-based node index (must be valid)
+     */
+    bool isDroneEligible(int id) const {
+        return droneEligibleFlag[id] != 0;
+    }
+
+    /**
+     * @brief True if a drone trip may meet its truck at this node: the bare round trip
+     * from the depot, before any wait, is within droneEndurance. A trip whose first
+     * customer (the rendezvous) fails this always takes the infeasible-trip penalty.
+     * Other members of a trip are handed over at the rendezvous and need no check.
+     * @param id 0-based node index (must be valid)
+     */
+    bool isDroneReachable(int id) const {
+        return droneReachableFlag[id] != 0;
     }
     
     /**
@@ -114,7 +340,7 @@ struct PDPData {
     bool isDepot(int id) const {
         return (id == depotIndex);
     }
-    
+
     /**
      * @brief Determine drone capacity based on instance size (paper specification).
      * Small instances (≤20 customers) use capacity 2; larger instances use capacity 10.
@@ -126,6 +352,51 @@ struct PDPData {
     }
 };
 
+/**
+ * @brief Node -> positions index of one route, for granular neighborhoods.
+ *
+ * candidates() walks a node's candidate list (PDPData::neighborList) and returns the
+ * route positions holding those nodes, so a scan costs O(n * K) instead of testing
+ * every position pair. A node may occur several times (the depot in a truck route).
+ * With candidate lists off (neighborK == 0) every position in the range is returned.
+ */
+class GranularIndex {
+public:
+    void build(const PDPData& data, const vector<int>& route) {
+        this->data = &data;
+        if (data.neighborK == 0) return;
+        head.assign(data.numNodes, -1);
+        next.assign(route.size(), -1);
+        for (int p = (int)route.size() - 1; p >= 0; --p) {
+            int node = route[p];
+            if (node < 0 || node >= data.numNodes) continue;
+            next[p] = head[node];
+            head[node] = p;
+        }
+    }
+
+    // Positions p in [lo, hi) whose node is a candidate of `node`, ascending
+    void candidates(int node, int lo, int hi, vector<int>& out) const {
+        out.clear();
+        if (data->neighborK == 0) {
+            for (int p = lo; p < hi; ++p) out.push_back(p);
+            return;
+        }
+        if (node < 0 || node >= data->numNodes) return;
+        for (int e = data->neighborStart[node]; e < data->neighborStart[node + 1]; ++e) {
+            for (int p = head[data->neighborList[e]]; p >= 0 && p < hi; p = next[p]) {
+                if (p >= lo) out.push_back(p);
+            }
+        }
+        sort(out.begin(), out.end());
+    }
+
+private:
+    const PDPData* data = nullptr;
+    vector<int> head;  // First position of each node, -1 = absent
+    vector<int> next;  // Next position holding the same node, -1 = none
+};
+
 // Structure storing detailed information about resupply events
 // ONE RENDEZVOUS MODEL: Drone bay đến 1 điểm hẹn duy nhất, giao TẤT CẢ packages cho truck
 // Sau đó truck tự đi giao cho các customers
@@ -171,4 +442,41 @@ struct PDPSolution : public Chromosome {
     vector<int> original_sequence;
 };
 
+// Objective values only (no routes / events), as returned by decodeCostOnly
+struct PDPCost {
+    double totalCost = 0.0;     // C_max
+    double totalPenalty = 0.0;  // Penalty for constraint violations
+    bool isFeasible = false;
+};
+
+/**
+ * @brief Wall-clock point by which a search must return its best result.
+ *
+ * Default-constructed = no limit. Searches poll expired() between iterations,
+ * so they overrun the deadline by at most one iteration.
+ */
+struct Deadline {
+    using Clock = std::chrono::steady_clock;
+
+    bool limited = false;
+    Clock::time_point at;
+
+    Deadline() = default;
+    static Deadline in(double seconds) {
+        Deadline d;
+        d.limited = true;
+        d.at = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                  std::chrono::duration<double>(seconds));
+        return d;
+    }
+
+    bool expired() const { return limited && Clock::now() >= at; }
+    // Seconds left (infinite when unlimited, 0 once expired)
+    double remaining() const {
+        if (!limited) return 1e300;
+        double left = std::chrono::duration<double>(at - Clock::now()).count();
+        return left > 0 ? left : 0.0;
+    }
+};
+
 #endif